@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include "prof.h"
 
 #define MAX_PROCESSES 100
 
@@ -25,12 +26,16 @@ void readData(char *filename) {
         exit(1);
     }
 
-    while (fscanf(file, "%[^;];%d;%d;%d;%d\n",
-                  processes[processCount].name,
-                  &processes[processCount].arrivalTime,
-                  &processes[processCount].burstTime,
-                  &processes[processCount].ioInterval,
-                  &processes[processCount].ioDuration) != EOF) {
+    // A sixth column (priority) may follow; it is only used by priority.c
+    char line[100];
+    while (fgets(line, sizeof(line), file)) {
+        if (sscanf(line, "%4[^;];%d;%d;%d;%d",
+                   processes[processCount].name,
+                   &processes[processCount].arrivalTime,
+                   &processes[processCount].burstTime,
+                   &processes[processCount].ioInterval,
+                   &processes[processCount].ioDuration) != 5)
+            continue;
         processes[processCount].remainingTime = processes[processCount].burstTime;
         processes[processCount].waitingTime = 0;
         processes[processCount].turnaroundTime = 0;
@@ -84,14 +89,17 @@ void sjf() {
         int minIdx = -1;
 
         // Check if any process has completed its I/O and can return to CPU
+        PROF_BEGIN(PHASE_IO);
         for (int i = 0; i < processCount; i++) {
             if (processes[i].inIO && (time - processes[i].insertedIOtime) >= processes[i].ioInterval) {
                 processes[i].inIO = false;
                 processes[i].insertedIOtime = -1;
             }
         }
+        PROF_END(PHASE_IO);
 
         // Find the shortest available job (not in I/O and arrived)
+        PROF_BEGIN(PHASE_PICK);
         for (int i = 0; i < processCount; i++) {
             if (!processes[i].executed && !processes[i].inIO && processes[i].arrivalTime <= time) {
                 if (minIdx == -1 || processes[i].remainingTime < processes[minIdx].remainingTime) {
@@ -99,6 +107,7 @@ void sjf() {
                 }
             }
         }
+        PROF_END(PHASE_PICK);
 
         // If no process is available, increment time
         if (minIdx == -1) {
@@ -107,6 +116,7 @@ void sjf() {
         }
 
         // Set response time if it's the first execution of the process
+        PROF_BEGIN(PHASE_UPDATE);
         if (processes[minIdx].responseTime == -1) {
             processes[minIdx].responseTime = time - processes[minIdx].arrivalTime;
         }
@@ -131,12 +141,14 @@ void sjf() {
             processes[minIdx].inIO = true;
             processes[minIdx].insertedIOtime = time;
         }
+        PROF_END(PHASE_UPDATE);
     }
 
     printProcesses();
 }
 
 int main() {
+    PROF_INIT();
     readData("data.txt");
     sjf();
     return 0;
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include "prof.h"
 
 #define MAX_PROCESSES 100
 
@@ -28,13 +29,17 @@ void readData(char *filename)
         exit(1);
     }
 
-    while (fscanf(file, "%[^;];%d;%d;%d;%d\n",
-                  processes[processCount].name,
-                  &processes[processCount].arrivalTime,
-                  &processes[processCount].burstTime,
-                  &processes[processCount].ioInterval,
-                  &processes[processCount].ioDuration) != EOF)
+    // A sixth column (priority) may follow; it is only used by priority.c
+    char line[100];
+    while (fgets(line, sizeof(line), file))
     {
+        if (sscanf(line, "%4[^;];%d;%d;%d;%d",
+                   processes[processCount].name,
+                   &processes[processCount].arrivalTime,
+                   &processes[processCount].burstTime,
+                   &processes[processCount].ioInterval,
+                   &processes[processCount].ioDuration) != 5)
+            continue;
         processes[processCount].remainingTime = processes[processCount].burstTime;
         processes[processCount].waitingTime = 0;
         processes[processCount].turnaroundTime = 0;
@@ -91,6 +96,7 @@ void srtf()
         int minIdx = -1;
 
         // Check if any process has completed its I/O and can return to CPU
+        PROF_BEGIN(PHASE_IO);
         for (int i = 0; i < processCount; i++)
         {
             if (processes[i].inIO && (time - processes[i].insertedIOtime) >= processes[i].ioDuration)
@@ -99,8 +105,10 @@ void srtf()
                 processes[i].insertedIOtime = -1;
             }
         }
+        PROF_END(PHASE_IO);
 
         // Find process with the shortest remaining time that is ready to execute
+        PROF_BEGIN(PHASE_PICK);
         for (int i = 0; i < processCount; i++)
         {
             if (!processes[i].executed && !processes[i].inIO && processes[i].arrivalTime <= time)
@@ -111,6 +119,7 @@ void srtf()
                 }
             }
         }
+        PROF_END(PHASE_PICK);
 
         // If no process is available, increment time
         if (minIdx == -1)
@@ -120,6 +129,7 @@ void srtf()
         }
 
         // If it's the first time the process is executing, set response time
+        PROF_BEGIN(PHASE_UPDATE);
         if (processes[minIdx].responseTime == -1)
         {
             processes[minIdx].responseTime = time - processes[minIdx].arrivalTime;
@@ -152,6 +162,7 @@ void srtf()
             processes[minIdx].inIO = true;
             processes[minIdx].insertedIOtime = time;
         }
+        PROF_END(PHASE_UPDATE);
     }
 
     printProcesses();
@@ -159,6 +170,7 @@ void srtf()
 
 int main()
 {
+    PROF_INIT();
     readData("data.txt");
     srtf();
     return 0;
@@ -0,0 +1,420 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+// Lockstep simulation of many independent workloads at once.
+//
+// Every batch holds BATCH_LANES workloads with the same number of processes.
+// Per-process state is kept as one vector per field (one lane per workload),
+// so each scheduling step runs over all lanes with masked updates instead of
+// per-workload branches. The scalar engines below are transcriptions of srtf()
+// in SRTF.c and round_robin() in rr.c and serve as the reference: each lane of
+// a batched run must produce exactly the same numbers as the scalar run of the
+// same workload.
+//
+// Build with vector support enabled, e.g. gcc -O2 -march=native.
+
+#include <stdbool.h>
+#include <limits.h>
+#include "trace.h"
+
+#define BATCH_LANES 8
+#define BATCH_MAX_PROCS 16
+#define RR_QUANTUM 5
+#define RR_QUEUE_SIZE 100
+
+typedef int vint __attribute__((vector_size(BATCH_LANES * sizeof(int))));
+
+// One row of data.txt: name;arrival;burst;ioInterval;ioDuration[;priority]
+struct Job {
+    int arrivalTime, burstTime;
+    int ioInterval, ioDuration;
+};
+
+struct Workload {
+    int count;
+    struct Job jobs[BATCH_MAX_PROCS];
+};
+
+struct Result {
+    int completionTime, turnaroundTime, waitingTime, responseTime;
+};
+
+static inline vint vselect(vint mask, vint a, vint b) {
+    return (a & mask) | (b & ~mask);
+}
+
+static inline bool vany(vint mask) {
+    for (int l = 0; l < BATCH_LANES; l++) {
+        if (mask[l]) return true;
+    }
+    return false;
+}
+
+// round_robin() advances its ring indices with plain increments in a few
+// places, so it only behaves while fewer than RR_QUEUE_SIZE enqueues happen.
+// Each slice enqueues at most once, so bound the number of slices.
+static inline bool rrQueueFits(const struct Workload* w) {
+    int enqueues = w->count;
+    for (int i = 0; i < w->count; i++) {
+        enqueues += (w->jobs[i].burstTime + RR_QUANTUM - 1) / RR_QUANTUM;
+    }
+    return enqueues < RR_QUEUE_SIZE - 1;
+}
+
+// Scalar SRTF, same decisions as srtf() in SRTF.c
+static void srtfScalar(const struct Workload* w, struct Result* out, Trace* trace) {
+    int n = w->count;
+    int remainingTime[BATCH_MAX_PROCS], waitingTime[BATCH_MAX_PROCS];
+    int completionTime[BATCH_MAX_PROCS], responseTime[BATCH_MAX_PROCS];
+    int insertedIOtime[BATCH_MAX_PROCS];
+    bool inIO[BATCH_MAX_PROCS], executed[BATCH_MAX_PROCS];
+    const struct Job* p = w->jobs;
+
+    for (int i = 0; i < n; i++) {
+        remainingTime[i] = p[i].burstTime;
+        waitingTime[i] = 0;
+        completionTime[i] = 0;
+        responseTime[i] = -1;
+        insertedIOtime[i] = -1;
+        inIO[i] = false;
+        executed[i] = false;
+    }
+
+    int completed = 0, time = 0;
+    while (completed < n) {
+        int minIdx = -1;
+
+        for (int i = 0; i < n; i++) {
+            if (inIO[i] && (time - insertedIOtime[i]) >= p[i].ioDuration) {
+                inIO[i] = false;
+                insertedIOtime[i] = -1;
+            }
+        }
+
+        for (int i = 0; i < n; i++) {
+            if (!executed[i] && !inIO[i] && p[i].arrivalTime <= time) {
+                if (minIdx == -1 || remainingTime[i] < remainingTime[minIdx]) {
+                    minIdx = i;
+                }
+            }
+        }
+
+        if (minIdx == -1) {
+            time++;
+            continue;
+        }
+
+        if (responseTime[minIdx] == -1) {
+            responseTime[minIdx] = time - p[minIdx].arrivalTime;
+        }
+
+        traceRun(trace, minIdx, time, 1);
+        remainingTime[minIdx]--;
+        time++;
+
+        for (int i = 0; i < n; i++) {
+            if (!executed[i] && !inIO[i] && p[i].arrivalTime <= time && i != minIdx) {
+                waitingTime[i]++;
+            }
+        }
+
+        if (remainingTime[minIdx] == 0) {
+            executed[minIdx] = true;
+            completionTime[minIdx] = time;
+            completed++;
+        } else if ((p[minIdx].burstTime - remainingTime[minIdx]) % p[minIdx].ioInterval == 0) {
+            inIO[minIdx] = true;
+            insertedIOtime[minIdx] = time;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        out[i].completionTime = completionTime[i];
+        out[i].turnaroundTime = completionTime[i] - p[i].arrivalTime;
+        out[i].waitingTime = waitingTime[i];
+        out[i].responseTime = responseTime[i];
+    }
+}
+
+// Scalar Round Robin, same decisions as round_robin() in rr.c
+static void roundRobinScalar(const struct Workload* w, struct Result* out, Trace* trace) {
+    int n = w->count;
+    int remainingBurst[BATCH_MAX_PROCS], burstTimeRate[BATCH_MAX_PROCS];
+    int completionTime[BATCH_MAX_PROCS], waitingTime[BATCH_MAX_PROCS];
+    bool done[BATCH_MAX_PROCS];
+    int queue[RR_QUEUE_SIZE + 1];
+    int front = 0, rear = 0, completedProcess = 0, time = 0;
+    const struct Job* p = w->jobs;
+
+    for (int i = 0; i < n; i++) {
+        remainingBurst[i] = p[i].burstTime;
+        burstTimeRate[i] = p[i].ioDuration;
+        completionTime[i] = 0;
+        waitingTime[i] = 0;
+        done[i] = false;
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (p[i].arrivalTime == 0) {
+            queue[rear] = i;
+            rear++;
+        }
+    }
+
+    while (completedProcess < n) {
+        if (front == rear) {
+            time++;
+            for (int i = 0; i < n; i++) {
+                if (p[i].arrivalTime == time && !done[i]) {
+                    queue[rear] = i;
+                    rear++;
+                }
+            }
+            continue;
+        }
+
+        int i = queue[front];
+        front = (front + 1) % RR_QUEUE_SIZE;
+
+        int timeSlice = (RR_QUANTUM < remainingBurst[i]) ? RR_QUANTUM : remainingBurst[i];
+        traceRun(trace, i, time, timeSlice);
+        time += timeSlice;
+        remainingBurst[i] -= timeSlice;
+
+        for (int j = 0; j < n; j++) {
+            if (!done[j] && p[j].arrivalTime > time - timeSlice && p[j].arrivalTime <= time) {
+                queue[rear] = j;
+                rear = (rear + 1) % RR_QUEUE_SIZE;
+            }
+        }
+
+        if (remainingBurst[i] == 0) {
+            completionTime[i] = time;
+            done[i] = true;
+            waitingTime[i] = time - p[i].arrivalTime - p[i].burstTime;
+            completedProcess++;
+        } else {
+            if (burstTimeRate[i] <= timeSlice) {
+                burstTimeRate[i] = p[i].ioInterval;
+            }
+            queue[rear] = i;
+            rear = (rear + 1) % RR_QUEUE_SIZE;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        out[i].completionTime = completionTime[i];
+        out[i].turnaroundTime = completionTime[i] - p[i].arrivalTime;
+        out[i].waitingTime = waitingTime[i];
+        out[i].responseTime = -1;  // round_robin() does not track it
+    }
+}
+
+// Transpose BATCH_LANES workloads of the same size into per-field vectors
+static void loadLanes(const struct Workload* w, int n, vint* arrival, vint* burst,
+                      vint* ioInterval, vint* ioDuration) {
+    for (int i = 0; i < n; i++) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            arrival[i][l] = w[l].jobs[i].arrivalTime;
+            burst[i][l] = w[l].jobs[i].burstTime;
+            ioInterval[i][l] = w[l].jobs[i].ioInterval;
+            ioDuration[i][l] = w[l].jobs[i].ioDuration;
+        }
+    }
+}
+
+// Batched SRTF: lane l of w and out is one srtfScalar() run.
+// All workloads in w must have the same count.
+static void srtfBatch(const struct Workload* w, struct Result out[][BATCH_MAX_PROCS]) {
+    int n = w[0].count;
+    vint arrival[BATCH_MAX_PROCS], burst[BATCH_MAX_PROCS];
+    vint ioInterval[BATCH_MAX_PROCS], ioDuration[BATCH_MAX_PROCS];
+    vint remainingTime[BATCH_MAX_PROCS], waitingTime[BATCH_MAX_PROCS];
+    vint completionTime[BATCH_MAX_PROCS], responseTime[BATCH_MAX_PROCS];
+    vint insertedIOtime[BATCH_MAX_PROCS], sinceIO[BATCH_MAX_PROCS];
+    vint inIO[BATCH_MAX_PROCS], executed[BATCH_MAX_PROCS];
+    vint zero = {0};
+    vint time = zero, completed = zero;
+
+    loadLanes(w, n, arrival, burst, ioInterval, ioDuration);
+    for (int i = 0; i < n; i++) {
+        remainingTime[i] = burst[i];
+        waitingTime[i] = zero;
+        completionTime[i] = zero;
+        responseTime[i] = zero - 1;
+        insertedIOtime[i] = zero - 1;
+        // CPU ticks since the last IO, i.e. (burst - remaining) % ioInterval
+        sinceIO[i] = zero;
+        inIO[i] = zero;
+        executed[i] = zero;
+    }
+
+    for (;;) {
+        vint active = completed < n;
+        if (!vany(active)) break;
+
+        // IO completions
+        for (int i = 0; i < n; i++) {
+            vint back = inIO[i] & ((time - insertedIOtime[i]) >= ioDuration[i]);
+            inIO[i] &= ~back;
+            insertedIOtime[i] = vselect(back, zero - 1, insertedIOtime[i]);
+        }
+
+        // Shortest remaining time among ready processes, first index wins ties
+        vint minIdx = zero - 1, minRemaining = zero + INT_MAX;
+        for (int i = 0; i < n; i++) {
+            vint ready = ~executed[i] & ~inIO[i] & (arrival[i] <= time);
+            vint better = ready & (remainingTime[i] < minRemaining);
+            minRemaining = vselect(better, remainingTime[i], minRemaining);
+            minIdx = vselect(better, zero + i, minIdx);
+        }
+
+        vint run = active & (minIdx != -1);
+        time -= active;
+
+        for (int i = 0; i < n; i++) {
+            vint sel = run & (minIdx == i);
+            vint first = sel & (responseTime[i] == -1);
+            responseTime[i] = vselect(first, time - 1 - arrival[i], responseTime[i]);
+            remainingTime[i] += sel;
+
+            vint waits = run & ~sel & ~executed[i] & ~inIO[i] & (arrival[i] <= time);
+            waitingTime[i] -= waits;
+
+            vint fin = sel & (remainingTime[i] == 0);
+            executed[i] |= fin;
+            completionTime[i] = vselect(fin, time, completionTime[i]);
+            completed -= fin;
+
+            vint ran = sel & ~fin;
+            sinceIO[i] -= ran;
+            vint toIO = ran & (sinceIO[i] == ioInterval[i]);
+            sinceIO[i] = vselect(toIO, zero, sinceIO[i]);
+            inIO[i] |= toIO;
+            insertedIOtime[i] = vselect(toIO, time, insertedIOtime[i]);
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            out[l][i].completionTime = completionTime[i][l];
+            out[l][i].turnaroundTime = completionTime[i][l] - arrival[i][l];
+            out[l][i].waitingTime = waitingTime[i][l];
+            out[l][i].responseTime = responseTime[i][l];
+        }
+    }
+}
+
+// Batched Round Robin: lane l of w and out is one roundRobinScalar() run.
+// All workloads in w must have the same count and satisfy rrQueueFits().
+//
+// A process is on the ready queue at most once, so instead of a ring buffer
+// per lane each queued process carries the ticket it was enqueued with. The
+// queue front is the queued process with the smallest ticket, found with the
+// same masked min-scan srtfBatch() uses. Under rrQueueFits() round_robin()'s
+// ring never wraps, so ticket order is exactly its queue order.
+static void roundRobinBatch(const struct Workload* w, struct Result out[][BATCH_MAX_PROCS]) {
+    int n = w[0].count;
+    vint arrival[BATCH_MAX_PROCS], burst[BATCH_MAX_PROCS];
+    vint ioInterval[BATCH_MAX_PROCS], ioDuration[BATCH_MAX_PROCS];
+    vint remainingBurst[BATCH_MAX_PROCS], burstTimeRate[BATCH_MAX_PROCS];
+    vint completionTime[BATCH_MAX_PROCS], waitingTime[BATCH_MAX_PROCS];
+    vint done[BATCH_MAX_PROCS], queued[BATCH_MAX_PROCS], ticket[BATCH_MAX_PROCS];
+    vint zero = {0};
+    vint rear = zero, completedProcess = zero, time = zero;
+
+    loadLanes(w, n, arrival, burst, ioInterval, ioDuration);
+    for (int i = 0; i < n; i++) {
+        remainingBurst[i] = burst[i];
+        burstTimeRate[i] = ioDuration[i];
+        completionTime[i] = zero;
+        waitingTime[i] = zero;
+        done[i] = zero;
+        queued[i] = arrival[i] == 0;
+        ticket[i] = rear;
+        rear -= queued[i];
+    }
+
+    for (;;) {
+        vint active = completedProcess < n;
+        if (!vany(active)) break;
+
+        // Queue front: the queued process with the smallest ticket
+        vint cur = zero - 1, minTicket = zero + INT_MAX;
+        for (int i = 0; i < n; i++) {
+            vint first = queued[i] & (ticket[i] < minTicket);
+            minTicket = vselect(first, ticket[i], minTicket);
+            cur = vselect(first, zero + i, cur);
+        }
+
+        // Lanes with an empty queue idle until the next arrival and admit it.
+        // round_robin() gets there one tick at a time; no tick in between
+        // enqueues anything, so jumping straight there is equivalent.
+        vint idle = active & (cur == -1);
+        if (vany(idle)) {
+            vint next = zero + INT_MAX;
+            for (int i = 0; i < n; i++) {
+                vint later = ~done[i] & (arrival[i] > time) & (arrival[i] < next);
+                next = vselect(later, arrival[i], next);
+            }
+            time = vselect(idle, next, time);
+            for (int i = 0; i < n; i++) {
+                vint admit = idle & (arrival[i] == time) & ~done[i];
+                queued[i] |= admit;
+                ticket[i] = vselect(admit, rear, ticket[i]);
+                rear -= admit;
+            }
+        }
+
+        vint slice = active & ~idle;
+        if (!vany(slice)) continue;
+
+        vint remaining = zero;
+        for (int i = 0; i < n; i++) {
+            vint sel = slice & (cur == i);
+            remaining = vselect(sel, remainingBurst[i], remaining);
+            queued[i] &= ~sel;
+        }
+        vint timeSlice = vselect(remaining > RR_QUANTUM, zero + RR_QUANTUM, remaining);
+        timeSlice &= slice;
+        time += timeSlice;
+
+        // Arrivals during the slice, in index order
+        for (int j = 0; j < n; j++) {
+            remainingBurst[j] -= timeSlice & (cur == j);
+            vint arrived = slice & ~done[j] & (arrival[j] > time - timeSlice) & (arrival[j] <= time);
+            queued[j] |= arrived;
+            ticket[j] = vselect(arrived, rear, ticket[j]);
+            rear -= arrived;
+        }
+
+        vint fin = slice & (remaining == timeSlice);
+        completedProcess -= fin;
+        for (int i = 0; i < n; i++) {
+            vint sel = slice & (cur == i);
+            vint finished = sel & fin;
+            completionTime[i] = vselect(finished, time, completionTime[i]);
+            waitingTime[i] = vselect(finished, time - arrival[i] - burst[i], waitingTime[i]);
+            done[i] |= finished;
+
+            vint requeue = sel & ~fin;
+            vint toIO = requeue & (burstTimeRate[i] <= timeSlice);
+            burstTimeRate[i] = vselect(toIO, ioInterval[i], burstTimeRate[i]);
+            queued[i] |= requeue;
+            ticket[i] = vselect(requeue, rear, ticket[i]);
+        }
+        // At most one process per lane was re-queued above
+        rear -= slice & ~fin;
+    }
+
+    for (int i = 0; i < n; i++) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            out[l][i].completionTime = completionTime[i][l];
+            out[l][i].turnaroundTime = completionTime[i][l] - arrival[i][l];
+            out[l][i].waitingTime = waitingTime[i][l];
+            out[l][i].responseTime = -1;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "batch.h"
+
+// Compares scalar and lockstep batched SRTF / Round Robin on random workloads.
+// Usage: ./batch_bench [workloads] [processes per workload] [seed]
+// Build: gcc -O2 -march=native batch_bench.c -o batch_bench
+// Exits nonzero if any batched result differs from the scalar one.
+
+struct Workload* workloads;
+struct Result (*scalarResults)[BATCH_MAX_PROCS];
+struct Result (*batchResults)[BATCH_MAX_PROCS];
+
+// Random workload shaped like data.txt
+void generateWorkload(struct Workload* w, int count) {
+    do {
+        w->count = count;
+        for (int i = 0; i < count; i++) {
+            w->jobs[i].arrivalTime = rand() % 20;
+            w->jobs[i].burstTime = 1 + rand() % 50;
+            w->jobs[i].ioInterval = 1 + rand() % 5;
+            w->jobs[i].ioDuration = 1 + rand() % 8;
+        }
+    } while (!rrQueueFits(w));
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int countMismatches(int numWorkloads) {
+    int mismatches = 0;
+    for (int k = 0; k < numWorkloads; k++) {
+        if (memcmp(scalarResults[k], batchResults[k], workloads[k].count * sizeof(struct Result)) != 0) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+// Returns the number of workloads whose batched results differ from scalar
+int bench(const char* label, int numWorkloads,
+           void (*scalar)(const struct Workload*, struct Result*, Trace*),
+           void (*batch)(const struct Workload*, struct Result[][BATCH_MAX_PROCS])) {
+    double start = now();
+    for (int k = 0; k < numWorkloads; k++) {
+        scalar(&workloads[k], scalarResults[k], NULL);
+    }
+    double scalarTime = now() - start;
+
+    start = now();
+    for (int k = 0; k < numWorkloads; k += BATCH_LANES) {
+        batch(&workloads[k], &batchResults[k]);
+    }
+    double batchTime = now() - start;
+
+    int mismatches = countMismatches(numWorkloads);
+    printf("%-6s scalar: %12.0f workloads/s   batched: %12.0f workloads/s   speedup: %.2fx   mismatches: %d\n",
+           label, numWorkloads / scalarTime, numWorkloads / batchTime,
+           scalarTime / batchTime, mismatches);
+    return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+    int numWorkloads = argc > 1 ? atoi(argv[1]) : 100000;
+    int count = argc > 2 ? atoi(argv[2]) : 4;
+    unsigned seed = argc > 3 ? (unsigned)atoi(argv[3]) : 1;
+
+    if (count < 1 || count > BATCH_MAX_PROCS) {
+        printf("Processes per workload must be between 1 and %d\n", BATCH_MAX_PROCS);
+        return 1;
+    }
+    // Whole batches only
+    numWorkloads = (numWorkloads + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES;
+
+    workloads = malloc(numWorkloads * sizeof(*workloads));
+    scalarResults = malloc(numWorkloads * sizeof(*scalarResults));
+    batchResults = malloc(numWorkloads * sizeof(*batchResults));
+    if (!workloads || !scalarResults || !batchResults) {
+        perror("Error allocating workloads");
+        return 1;
+    }
+
+    srand(seed);
+    for (int k = 0; k < numWorkloads; k++) {
+        generateWorkload(&workloads[k], count);
+    }
+
+    printf("%d workloads x %d processes, %d lanes\n", numWorkloads, count, BATCH_LANES);
+    int mismatches = bench("SRTF", numWorkloads, srtfScalar, srtfBatch);
+    mismatches += bench("RR", numWorkloads, roundRobinScalar, roundRobinBatch);
+
+    free(workloads);
+    free(scalarResults);
+    free(batchResults);
+    return mismatches != 0;
+}
@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "node.h"
+
+// Fleet of nodes behind a front-end dispatcher.
+//
+// Every node runs one of the single-machine policies from node.h. Jobs arrive
+// at the dispatcher, which places each one on a node as it arrives. Nodes are
+// simulated in parallel by worker threads and synchronised conservatively: at
+// each arrival time all nodes are first advanced up to that tick, so the
+// dispatcher sees every node's load as of the arrival.
+//
+// Usage: ./cluster [nodes] [policy] [dispatch] [jobs] [load] [seed]
+//   policy    rr | vrr | sjf | srtf
+//   dispatch  random | rr | jsq | p2c
+//   load      offered CPU load per node, e.g. 0.8
+// Build: gcc -O2 cluster.c -o cluster -lpthread -lm
+
+#define MAX_NODES 64
+#define MAX_THREADS 16
+#define DRAIN -1
+#define QUIT -2
+
+typedef enum {
+    DISPATCH_RANDOM,
+    DISPATCH_RR,
+    DISPATCH_JSQ,
+    DISPATCH_P2C,
+    DISPATCH_COUNT
+} Dispatch;
+
+static const char* dispatchNames[DISPATCH_COUNT] = { "random", "rr", "jsq", "p2c" };
+
+typedef struct {
+    int arrivalTime, burstTime;
+    int ioInterval, ioDuration;
+    int node;
+    int completionTime, waitingTime;
+} Job;
+
+typedef struct {
+    Node* nodes[MAX_NODES];
+    int numNodes;
+    int numThreads;
+    int target;  // tick to advance to, or DRAIN / QUIT
+    pthread_barrier_t start, done;
+} Cluster;
+
+typedef struct {
+    Cluster* c;
+    int first;  // this worker simulates nodes first, first + numThreads, ...
+} Worker;
+
+void* workerLoop(void* arg) {
+    Worker* w = arg;
+    Cluster* c = w->c;
+
+    for (;;) {
+        pthread_barrier_wait(&c->start);
+        int target = c->target;
+        if (target == QUIT) break;
+        for (int i = w->first; i < c->numNodes; i += c->numThreads) {
+            if (target == DRAIN) {
+                nodeDrain(c->nodes[i]);
+            } else {
+                nodeAdvance(c->nodes[i], target);
+            }
+        }
+        pthread_barrier_wait(&c->done);
+    }
+    return NULL;
+}
+
+// Runs one round of the workers: every node advances to target
+void advanceAll(Cluster* c, int target) {
+    c->target = target;
+    pthread_barrier_wait(&c->start);
+    pthread_barrier_wait(&c->done);
+}
+
+int pickNode(Cluster* c, Dispatch dispatch, unsigned* seed, int* next) {
+    int n = c->numNodes;
+    switch (dispatch) {
+    case DISPATCH_RANDOM:
+        return rand_r(seed) % n;
+    case DISPATCH_RR: {
+        int node = *next;
+        *next = (*next + 1) % n;
+        return node;
+    }
+    case DISPATCH_JSQ: {
+        // Ties go to a uniformly random shortest queue (reservoir sampling)
+        int best = 0, bestLoad = nodeLoad(c->nodes[0]), ties = 1;
+        for (int i = 1; i < n; i++) {
+            int load = nodeLoad(c->nodes[i]);
+            if (load < bestLoad) {
+                best = i;
+                bestLoad = load;
+                ties = 1;
+            } else if (load == bestLoad && rand_r(seed) % ++ties == 0) {
+                best = i;
+            }
+        }
+        return best;
+    }
+    case DISPATCH_P2C: {
+        int a = rand_r(seed) % n;
+        int b = n > 1 ? (a + 1 + rand_r(seed) % (n - 1)) % n : a;
+        return nodeLoad(c->nodes[b]) < nodeLoad(c->nodes[a]) ? b : a;
+    }
+    default:
+        return 0;
+    }
+}
+
+// Random jobs shaped like data.txt with Poisson arrivals at the given load
+void generateJobs(Job* jobs, int numJobs, int numNodes, double load, unsigned* seed) {
+    double meanBurst = 25.5;
+    double rate = load * numNodes / meanBurst;
+    double t = 0;
+    for (int i = 0; i < numJobs; i++) {
+        t += -log((rand_r(seed) + 1.0) / (RAND_MAX + 2.0)) / rate;
+        jobs[i].arrivalTime = (int)t;
+        jobs[i].burstTime = 1 + rand_r(seed) % 50;
+        jobs[i].ioInterval = 1 + rand_r(seed) % 5;
+        jobs[i].ioDuration = 1 + rand_r(seed) % 8;
+        jobs[i].node = -1;
+    }
+}
+
+int compareInt(const void* a, const void* b) {
+    return (*(const int*)a > *(const int*)b) - (*(const int*)a < *(const int*)b);
+}
+
+// Nearest-rank percentile of a sorted array
+int percentile(int* sorted, int count, double pct) {
+    int rank = (int)ceil(pct / 100.0 * count);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void printResults(Cluster* c, Job* jobs, int numJobs) {
+    int makespan = 0;
+    for (int i = 0; i < c->numNodes; i++) {
+        if (c->nodes[i]->lastCompletion > makespan) makespan = c->nodes[i]->lastCompletion;
+    }
+
+    printf("\nPer-Node Results:\n");
+    printf("------------------------------------------------------------\n");
+    printf("Node  Jobs     Busy       Utilization\n");
+    for (int i = 0; i < c->numNodes; i++) {
+        Node* n = c->nodes[i];
+        printf("%-5d %-8d %-10ld %6.2f%%\n", i, n->count, n->busyTicks,
+               makespan ? 100.0 * n->busyTicks / makespan : 0.0);
+    }
+
+    int* latency = malloc(numJobs * sizeof(int));
+    double totalLatency = 0, totalWaiting = 0;
+    for (int i = 0; i < numJobs; i++) {
+        latency[i] = jobs[i].completionTime - jobs[i].arrivalTime;
+        totalLatency += latency[i];
+        totalWaiting += jobs[i].waitingTime;
+    }
+    qsort(latency, numJobs, sizeof(int), compareInt);
+
+    printf("\nFleet Turnaround Time:\n");
+    printf("------------------------------------------------------------\n");
+    printf("Mean : %f\n", totalLatency / numJobs);
+    printf("p50  : %d\n", percentile(latency, numJobs, 50));
+    printf("p90  : %d\n", percentile(latency, numJobs, 90));
+    printf("p99  : %d\n", percentile(latency, numJobs, 99));
+    printf("p99.9: %d\n", percentile(latency, numJobs, 99.9));
+    printf("Max  : %d\n", latency[numJobs - 1]);
+    printf("\nAverage Waiting Time : %f\n", totalWaiting / numJobs);
+    printf("Makespan : %d\n", makespan);
+    printf("------------------------------------------------------------\n");
+    free(latency);
+}
+
+int main(int argc, char* argv[]) {
+    int numNodes = argc > 1 ? atoi(argv[1]) : 8;
+    int policy = parsePolicy(argc > 2 ? argv[2] : "srtf");
+    int dispatch = -1;
+    const char* dispatchName = argc > 3 ? argv[3] : "jsq";
+    int numJobs = argc > 4 ? atoi(argv[4]) : 10000;
+    double load = argc > 5 ? atof(argv[5]) : 0.8;
+    unsigned seed = argc > 6 ? (unsigned)atoi(argv[6]) : 1;
+
+    for (int d = 0; d < DISPATCH_COUNT; d++) {
+        if (strcmp(dispatchName, dispatchNames[d]) == 0) dispatch = d;
+    }
+    if (numNodes < 1 || numNodes > MAX_NODES || policy < 0 || dispatch < 0 ||
+        numJobs < 1 || load <= 0) {
+        printf("Usage: %s [nodes<=%d] [rr|vrr|sjf|srtf] [random|rr|jsq|p2c] [jobs] [load] [seed]\n",
+               argv[0], MAX_NODES);
+        return 1;
+    }
+
+    Job* jobs = malloc(numJobs * sizeof(Job));
+    NodeProc* results = malloc(numJobs * sizeof(NodeProc));
+    if (!jobs || !results) {
+        perror("Error allocating jobs");
+        return 1;
+    }
+    Cluster c;
+    c.numNodes = numNodes;
+    c.numThreads = numNodes < MAX_THREADS ? numNodes : MAX_THREADS;
+    for (int i = 0; i < numNodes; i++) {
+        c.nodes[i] = malloc(sizeof(Node));
+        if (!c.nodes[i]) {
+            perror("Error allocating node");
+            return 1;
+        }
+        nodeInit(c.nodes[i], policy);
+        c.nodes[i]->results = results;  // job ids are unique across nodes
+    }
+    generateJobs(jobs, numJobs, numNodes, load, &seed);
+
+    pthread_barrier_init(&c.start, NULL, c.numThreads + 1);
+    pthread_barrier_init(&c.done, NULL, c.numThreads + 1);
+    pthread_t threads[MAX_THREADS];
+    Worker workers[MAX_THREADS];
+    for (int t = 0; t < c.numThreads; t++) {
+        workers[t].c = &c;
+        workers[t].first = t;
+        pthread_create(&threads[t], NULL, workerLoop, &workers[t]);
+    }
+
+    printf("\nSimulating %d jobs on %d %s nodes, %s dispatch, load %.2f...\n",
+           numJobs, numNodes, policyNames[policy], dispatchNames[dispatch], load);
+
+    // One synchronisation round per distinct arrival time
+    int next = 0;
+    for (int i = 0; i < numJobs;) {
+        int now = jobs[i].arrivalTime;
+        advanceAll(&c, now);
+        for (; i < numJobs && jobs[i].arrivalTime == now; i++) {
+            int node = pickNode(&c, dispatch, &seed, &next);
+            jobs[i].node = node;
+            nodeAdmit(c.nodes[node], i, jobs[i].arrivalTime, jobs[i].burstTime,
+                      jobs[i].ioInterval, jobs[i].ioDuration);
+        }
+    }
+    advanceAll(&c, DRAIN);
+
+    c.target = QUIT;
+    pthread_barrier_wait(&c.start);
+    for (int t = 0; t < c.numThreads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_barrier_destroy(&c.start);
+    pthread_barrier_destroy(&c.done);
+
+    for (int i = 0; i < numJobs; i++) {
+        jobs[i].completionTime = results[i].completionTime;
+        jobs[i].waitingTime = results[i].waitingTime;
+    }
+    printResults(&c, jobs, numJobs);
+
+    for (int i = 0; i < numNodes; i++) {
+        free(c.nodes[i]);
+    }
+    free(results);
+    free(jobs);
+    return 0;
+}
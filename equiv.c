@@ -0,0 +1,658 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "batch.h"
+#include "node.h"
+
+// Differential equivalence harness.
+//
+// Runs a reference engine and an optimised engine on the same random workloads
+// and compares per-process completion, waiting and response times, and with -e
+// the full sequence of CPU runs. The references are the scalar transcriptions
+// of srtf() and round_robin() in batch.h plus sjfReference() and
+// vrrReference() below, which follow sjf() in SJF.c and processor() in vrr.c
+// with the printing left out. Before any random workload, every reference is
+// run on data.txt and must reproduce the per-process results the stand-alone
+// program prints for it. On a mismatch the workload is shrunk to a minimal
+// counterexample and printed in data.txt format.
+//
+// The lockstep batch engines keep no trace, so -e does not cover their pairs;
+// those are compared on results only.
+//
+// Usage: ./equiv [-n workloads] [-s seed] [-p pair] [-e] [-x] [-j threads]
+//   -p  only run pairs whose name starts with this prefix
+//   -e  also compare event sequences
+//   -x  add a deliberately wrong pair, to check that mismatches are caught
+//   -j  worker threads (default: one per CPU)
+// Build: gcc -O2 -march=native equiv.c -o equiv -lpthread
+//
+// Workloads are generated in fixed blocks with a seed per block, so a run
+// checks the same workloads and reports the same counterexample whatever the
+// number of threads.
+
+#define GEN_MAX_PROCS 6
+#define BLOCK_SIZE 4096  // workloads per block, a multiple of BATCH_LANES
+
+typedef void (*Engine)(const struct Workload*, struct Result*, Trace*);
+
+typedef struct {
+    const char* name;
+    Engine reference;
+    Engine optimised;
+    void (*batch)(const struct Workload*, struct Result[][BATCH_MAX_PROCS]);  // lockstep engine, if any
+    bool sorted;          // workloads are fed in arrival order
+    bool checkResponse;   // the reference tracks response times
+    bool enabled;
+} Pair;
+
+static __thread Node node;  // reused by every node-engine run on a thread
+static bool compareEvents = false;
+
+// Quiet transcription of sjf() in SJF.c
+void sjfReference(const struct Workload* w, struct Result* out, Trace* trace) {
+    int n = w->count;
+    int remainingTime[BATCH_MAX_PROCS], waitingTime[BATCH_MAX_PROCS];
+    int completionTime[BATCH_MAX_PROCS], responseTime[BATCH_MAX_PROCS];
+    int insertedIOtime[BATCH_MAX_PROCS];
+    bool inIO[BATCH_MAX_PROCS], executed[BATCH_MAX_PROCS];
+    const struct Job* p = w->jobs;
+
+    for (int i = 0; i < n; i++) {
+        remainingTime[i] = p[i].burstTime;
+        waitingTime[i] = 0;
+        completionTime[i] = 0;
+        responseTime[i] = -1;
+        insertedIOtime[i] = -1;
+        inIO[i] = false;
+        executed[i] = false;
+    }
+
+    int completed = 0, time = 0;
+    while (completed < n) {
+        int minIdx = -1;
+
+        for (int i = 0; i < n; i++) {
+            if (inIO[i] && (time - insertedIOtime[i]) >= p[i].ioInterval) {
+                inIO[i] = false;
+                insertedIOtime[i] = -1;
+            }
+        }
+
+        for (int i = 0; i < n; i++) {
+            if (!executed[i] && !inIO[i] && p[i].arrivalTime <= time) {
+                if (minIdx == -1 || remainingTime[i] < remainingTime[minIdx]) {
+                    minIdx = i;
+                }
+            }
+        }
+
+        if (minIdx == -1) {
+            time++;
+            continue;
+        }
+
+        if (responseTime[minIdx] == -1) {
+            responseTime[minIdx] = time - p[minIdx].arrivalTime;
+        }
+
+        int executedTime = (remainingTime[minIdx] < p[minIdx].ioDuration) ?
+                           remainingTime[minIdx] : p[minIdx].ioDuration;
+        traceRun(trace, minIdx, time, executedTime);
+        time += executedTime;
+        remainingTime[minIdx] -= executedTime;
+
+        if (remainingTime[minIdx] == 0) {
+            executed[minIdx] = true;
+            waitingTime[minIdx] = time - p[minIdx].arrivalTime - p[minIdx].burstTime;
+            completionTime[minIdx] = time;
+            completed++;
+        } else {
+            inIO[minIdx] = true;
+            insertedIOtime[minIdx] = time;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        out[i].completionTime = completionTime[i];
+        out[i].turnaroundTime = completionTime[i] - p[i].arrivalTime;
+        out[i].waitingTime = waitingTime[i];
+        out[i].responseTime = responseTime[i];
+    }
+}
+
+// Process and queue as in vrr.c, with the row index in place of the name
+typedef struct {
+    int pid;
+    size_t arrivalTime;
+    size_t burstTimeIO;
+    size_t burstTimeRate;
+    size_t burstRemainCPU;
+    size_t lastIOBurst;
+    int saveContextOfq;
+} VrrProcess;
+
+typedef struct {
+    VrrProcess data[BATCH_MAX_PROCS];
+    int front;
+    int size;
+} VrrQueue;
+
+static void vrrEnqueue(VrrQueue* q, VrrProcess p) {
+    q->data[(q->front + q->size++) % BATCH_MAX_PROCS] = p;
+}
+
+static VrrProcess vrrDequeue(VrrQueue* q) {
+    VrrProcess p = q->data[q->front];
+    q->front = (q->front + 1) % BATCH_MAX_PROCS;
+    q->size--;
+    return p;
+}
+
+// Quiet transcription of processor() in vrr.c. It never records a real start
+// time, so there is no response time to report.
+void vrrReference(const struct Workload* w, struct Result* out, Trace* trace) {
+    VrrProcess procs[BATCH_MAX_PROCS];
+    size_t numProcs = w->count, totalProc = w->count, ticksCPU = 0, timeQuantum = 5;
+    for (int i = 0; i < w->count; i++) {
+        procs[i].pid = i;
+        procs[i].arrivalTime = w->jobs[i].arrivalTime;
+        procs[i].burstTimeIO = w->jobs[i].ioInterval;
+        procs[i].burstTimeRate = w->jobs[i].ioDuration;
+        procs[i].burstRemainCPU = w->jobs[i].burstTime;
+        procs[i].lastIOBurst = 0;
+        procs[i].saveContextOfq = 0;
+    }
+
+    VrrQueue readyQ = { .front = 0, .size = 0 }, auxQ = readyQ, ioQ = readyQ;
+    VrrProcess execProc, execProcIO;
+    memset(&execProc, 0, sizeof(execProc));
+    memset(&execProcIO, 0, sizeof(execProcIO));
+    int isCPUIdle = 1, isIOIdle = 1, q = 0;
+    size_t countIOBurst = 0;
+
+    while (totalProc) {
+        // checkFreshArrivals()
+        size_t i = 0;
+        while (i < numProcs) {
+            if (procs[i].arrivalTime == ticksCPU) {
+                vrrEnqueue(&readyQ, procs[i]);
+                for (size_t j = i; j < numProcs - 1; j++) {
+                    procs[j] = procs[j + 1];
+                }
+                numProcs--;
+                continue;
+            }
+            i++;
+        }
+
+        if (!isCPUIdle) {
+            // execProcess()
+            traceRun(trace, execProc.pid, (int)ticksCPU - 1, 1);
+            if (--execProc.burstRemainCPU <= 0) {
+                isCPUIdle = 1;
+                totalProc--;
+                out[execProc.pid].completionTime = (int)ticksCPU;
+            } else if (++execProc.lastIOBurst >= execProc.burstTimeRate) {
+                execProc.lastIOBurst = 0;
+                execProc.saveContextOfq = (q + 1) % timeQuantum;
+                vrrEnqueue(&ioQ, execProc);
+                isCPUIdle = 1;
+            }
+        }
+
+        int toSchedule = (readyQ.size || auxQ.size) && (isCPUIdle || q + 1 >= (int)timeQuantum);
+        if (toSchedule) {
+            VrrProcess proc;
+            if (auxQ.size) {
+                proc = vrrDequeue(&auxQ);
+                q = proc.saveContextOfq - 1;
+            } else {
+                proc = vrrDequeue(&readyQ);
+                q = -1;
+            }
+            if (!isCPUIdle) {
+                vrrEnqueue(&readyQ, execProc);
+            }
+            execProc = proc;
+            isCPUIdle = 0;
+        }
+
+        // ioDevice()
+        if (!isIOIdle) {
+            if (++countIOBurst >= execProcIO.burstTimeIO) {
+                vrrEnqueue(&auxQ, execProcIO);
+                isIOIdle = 1;
+            }
+        }
+        if (isIOIdle && ioQ.size) {
+            execProcIO = vrrDequeue(&ioQ);
+            countIOBurst = 0;
+            isIOIdle = 0;
+        }
+
+        ticksCPU++;
+        q++;
+    }
+
+    for (int i = 0; i < w->count; i++) {
+        out[i].turnaroundTime = out[i].completionTime - w->jobs[i].arrivalTime;
+        out[i].waitingTime = out[i].turnaroundTime - w->jobs[i].burstTime;
+        out[i].responseTime = -1;
+    }
+}
+
+// Runs a workload on a Node. Online nodes get each job at its arrival tick,
+// the way cluster.c feeds them; offline nodes get everything up front.
+void runNode(const struct Workload* w, struct Result* out, Trace* trace, Policy policy, bool online) {
+    NodeProc results[BATCH_MAX_PROCS];
+    nodeInit(&node, policy);
+    node.trace = trace;
+    node.results = results;
+    for (int i = 0; i < w->count; i++) {
+        const struct Job* j = &w->jobs[i];
+        if (online) nodeAdvance(&node, j->arrivalTime);
+        nodeAdmit(&node, i, j->arrivalTime, j->burstTime, j->ioInterval, j->ioDuration);
+    }
+    nodeDrain(&node);
+    for (int i = 0; i < w->count; i++) {
+        NodeProc* p = &results[i];
+        out[i].completionTime = p->completionTime;
+        out[i].turnaroundTime = p->completionTime - p->arrivalTime;
+        out[i].waitingTime = p->waitingTime;
+        out[i].responseTime = policy == POLICY_RR ? -1 : p->responseTime;
+    }
+}
+
+void srtfNode(const struct Workload* w, struct Result* out, Trace* t) { runNode(w, out, t, POLICY_SRTF, false); }
+void sjfNode(const struct Workload* w, struct Result* out, Trace* t) { runNode(w, out, t, POLICY_SJF, false); }
+void rrNode(const struct Workload* w, struct Result* out, Trace* t) { runNode(w, out, t, POLICY_RR, false); }
+void vrrNode(const struct Workload* w, struct Result* out, Trace* t) { runNode(w, out, t, POLICY_VRR, false); }
+void srtfNodeOnline(const struct Workload* w, struct Result* out, Trace* t) { runNode(w, out, t, POLICY_SRTF, true); }
+void sjfNodeOnline(const struct Workload* w, struct Result* out, Trace* t) { runNode(w, out, t, POLICY_SJF, true); }
+void rrNodeOnline(const struct Workload* w, struct Result* out, Trace* t) { runNode(w, out, t, POLICY_RR, true); }
+void vrrNodeOnline(const struct Workload* w, struct Result* out, Trace* t) { runNode(w, out, t, POLICY_VRR, true); }
+
+// A lockstep engine run with every lane on the same workload, for shrinking
+void runBatchOne(void (*batch)(const struct Workload*, struct Result[][BATCH_MAX_PROCS]),
+                 const struct Workload* w, struct Result* out) {
+    struct Workload lanes[BATCH_LANES];
+    struct Result results[BATCH_LANES][BATCH_MAX_PROCS];
+    for (int l = 0; l < BATCH_LANES; l++) lanes[l] = *w;
+    batch(lanes, results);
+    memcpy(out, results[0], w->count * sizeof(struct Result));
+}
+
+// Self-test: SRTF that breaks remaining-time ties towards the last process
+void srtfLastWins(const struct Workload* w, struct Result* out, Trace* trace) {
+    struct Workload reversed = *w;
+    struct Result results[BATCH_MAX_PROCS];
+    for (int i = 0; i < w->count; i++) reversed.jobs[i] = w->jobs[w->count - 1 - i];
+    srtfScalar(&reversed, results, trace);
+    for (int i = 0; i < w->count; i++) out[i] = results[w->count - 1 - i];
+    for (int k = 0; trace && k < trace->count; k++) {
+        trace->runs[k].pid = w->count - 1 - trace->runs[k].pid;
+    }
+}
+
+Pair pairs[] = {
+    { "srtf/batch",       srtfScalar,       NULL,           srtfBatch,       false, true,  true },
+    { "rr/batch",         roundRobinScalar, NULL,           roundRobinBatch, false, false, true },
+    { "srtf/node",        srtfScalar,       srtfNode,       NULL,            false, true,  true },
+    { "sjf/node",         sjfReference,     sjfNode,        NULL,            false, true,  true },
+    { "rr/node",          roundRobinScalar, rrNode,         NULL,            false, false, true },
+    { "vrr/node",         vrrReference,     vrrNode,        NULL,            false, false, true },
+    { "srtf/node-online", srtfScalar,       srtfNodeOnline, NULL,            true,  true,  true },
+    { "sjf/node-online",  sjfReference,     sjfNodeOnline,  NULL,            true,  true,  true },
+    { "rr/node-online",   roundRobinScalar, rrNodeOnline,   NULL,            true,  false, true },
+    { "vrr/node-online",  vrrReference,     vrrNodeOnline,  NULL,            true,  false, true },
+    { "srtf/selftest",    srtfScalar,       srtfLastWins,   NULL,            false, true,  false },
+};
+#define NUM_PAIRS ((int)(sizeof(pairs) / sizeof(pairs[0])))
+
+// Small random workload. Arrivals are clustered so that ties are common.
+void generateWorkload(struct Workload* w, int count, unsigned* seed) {
+    w->count = count;
+    int t = 0;
+    for (int i = 0; i < count; i++) {
+        if (rand_r(seed) % 2) t += rand_r(seed) % 8;
+        w->jobs[i].arrivalTime = rand_r(seed) % 4 ? t : rand_r(seed) % (t + 1);
+        w->jobs[i].burstTime = 1 + rand_r(seed) % 20;
+        w->jobs[i].ioInterval = 1 + rand_r(seed) % 5;
+        w->jobs[i].ioDuration = 1 + rand_r(seed) % 6;
+    }
+}
+
+// Stable sort by arrival time
+void sortByArrival(struct Workload* w) {
+    for (int i = 1; i < w->count; i++) {
+        struct Job job = w->jobs[i];
+        int j = i;
+        while (j > 0 && w->jobs[j - 1].arrivalTime > job.arrivalTime) {
+            w->jobs[j] = w->jobs[j - 1];
+            j--;
+        }
+        w->jobs[j] = job;
+    }
+}
+
+bool sameResults(const Pair* pair, const struct Workload* w, const struct Result* a, const struct Result* b) {
+    for (int i = 0; i < w->count; i++) {
+        if (a[i].completionTime != b[i].completionTime ||
+            a[i].turnaroundTime != b[i].turnaroundTime ||
+            a[i].waitingTime != b[i].waitingTime ||
+            (pair->checkResponse && a[i].responseTime != b[i].responseTime)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// data.txt, and what each stand-alone program prints for it
+const struct Workload dataTxt = { 4, { { 0, 24, 2, 5 }, { 3, 17, 3, 6 }, { 8, 50, 2, 5 }, { 15, 10, 3, 6 } } };
+
+typedef struct {
+    const char* program;
+    Engine reference;
+    bool checkResponse;
+    struct Result expected[4];  // completion, turnaround, waiting, response
+} Known;
+
+Known known[] = {
+    { "SRTF.c", srtfScalar, true,
+      { { 87, 87, 8, 0 }, { 50, 47, 0, 0 }, { 201, 193, 24, 1 }, { 43, 28, 1, 0 } } },
+    { "SJF.c", sjfReference, true,
+      { { 61, 61, 37, 0 }, { 37, 34, 17, 2 }, { 115, 107, 57, 34 }, { 32, 17, 7, 1 } } },
+    { "rr.c", roundRobinScalar, false,
+      { { 66, 66, 42, -1 }, { 62, 59, 42, -1 }, { 101, 93, 43, -1 }, { 50, 35, 25, -1 } } },
+    // vrr.c has data.txt built into main(); its response times are not meaningful
+    { "vrr.c", vrrReference, false,
+      { { 44, 44, 20, -1 }, { 91, 88, 71, -1 }, { 105, 97, 47, -1 }, { 81, 66, 56, -1 } } },
+};
+#define NUM_KNOWN ((int)(sizeof(known) / sizeof(known[0])))
+
+// Runs every reference on data.txt; returns the number that disagree with
+// their program
+int checkKnown(void) {
+    int failed = 0;
+    for (int k = 0; k < NUM_KNOWN; k++) {
+        struct Result out[BATCH_MAX_PROCS];
+        Pair pair = { .checkResponse = known[k].checkResponse };
+        known[k].reference(&dataTxt, out, NULL);
+        bool same = sameResults(&pair, &dataTxt, known[k].expected, out);
+        printf("%-18s %10s data.txt%29s%s\n", known[k].program, "", "", same ? "ok" : "FAIL");
+        if (same) continue;
+        failed++;
+        printf("PID  Completion   Turnaround   Waiting      Response     (program/reference)\n");
+        for (int i = 0; i < dataTxt.count; i++) {
+            printf("P%-3d %5d/%-6d %5d/%-6d %5d/%-6d %5d/%-6d\n", i,
+                   known[k].expected[i].completionTime, out[i].completionTime,
+                   known[k].expected[i].turnaroundTime, out[i].turnaroundTime,
+                   known[k].expected[i].waitingTime, out[i].waitingTime,
+                   known[k].expected[i].responseTime, out[i].responseTime);
+        }
+    }
+    return failed;
+}
+
+bool sameTrace(const Trace* a, const Trace* b) {
+    return a->count == b->count && a->overflow == b->overflow &&
+           memcmp(a->runs, b->runs, a->count * sizeof(TraceRun)) == 0;
+}
+
+static __thread Trace refTrace, optTrace;
+
+// Runs both engines of a pair on one workload; true when they agree
+bool agree(const Pair* pair, const struct Workload* w, struct Result* ref, struct Result* opt) {
+    bool events = compareEvents && !pair->batch;
+    if (events) {
+        traceInit(&refTrace);
+        traceInit(&optTrace);
+    }
+    pair->reference(w, ref, events ? &refTrace : NULL);
+    if (pair->batch) {
+        runBatchOne(pair->batch, w, opt);
+    } else {
+        pair->optimised(w, opt, events ? &optTrace : NULL);
+    }
+    return sameResults(pair, w, ref, opt) && (!events || sameTrace(&refTrace, &optTrace));
+}
+
+// Keeps a candidate workload if it is valid and the engines still disagree
+bool tryShrink(const Pair* pair, struct Workload* w, struct Workload* candidate) {
+    struct Result ref[BATCH_MAX_PROCS], opt[BATCH_MAX_PROCS];
+    if (pair->sorted) sortByArrival(candidate);
+    if (pair->reference == roundRobinScalar && !rrQueueFits(candidate)) return false;
+    if (memcmp(candidate, w, sizeof(*w)) == 0 || agree(pair, candidate, ref, opt)) return false;
+    *w = *candidate;
+    return true;
+}
+
+int* jobField(struct Job* job, int field) {
+    switch (field) {
+    case 0:
+        return &job->arrivalTime;
+    case 1:
+        return &job->burstTime;
+    case 2:
+        return &job->ioInterval;
+    default:
+        return &job->ioDuration;
+    }
+}
+
+// Greedy shrinking to a fixed point: drop processes, then lower each field
+// to its minimum, by halving, or by one.
+void shrink(const Pair* pair, struct Workload* w) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (int i = 0; i < w->count && w->count > 1; i++) {
+            struct Workload c = *w;
+            memmove(&c.jobs[i], &c.jobs[i + 1], (c.count - i - 1) * sizeof(struct Job));
+            c.count--;
+            if (tryShrink(pair, w, &c)) {
+                progress = true;
+                i--;
+            }
+        }
+        for (int i = 0; i < w->count; i++) {
+            for (int f = 0; f < 4; f++) {
+                int minimum = f == 0 ? 0 : 1;
+                for (;;) {
+                    int value = *jobField(&w->jobs[i], f);
+                    if (value <= minimum) break;
+                    int tries[3] = { minimum, minimum + (value - minimum) / 2, value - 1 };
+                    bool shrunk = false;
+                    for (int k = 0; k < 3 && !shrunk; k++) {
+                        struct Workload c = *w;
+                        *jobField(&c.jobs[i], f) = tries[k];
+                        shrunk = tryShrink(pair, w, &c);
+                    }
+                    if (!shrunk) break;
+                    progress = true;
+                    // sorting may have moved the job; restart on the new layout
+                    if (pair->sorted) break;
+                }
+            }
+        }
+    }
+}
+
+void printTrace(const char* label, const Trace* t) {
+    printf("%-10s", label);
+    for (int k = 0; k < t->count; k++) {
+        printf(" P%d[%d,%d)", t->runs[k].pid, t->runs[k].start, t->runs[k].end);
+    }
+    printf("%s\n", t->overflow ? " ..." : "");
+}
+
+void reportMismatch(const Pair* pair, struct Workload* w, int originalCount) {
+    struct Result ref[BATCH_MAX_PROCS], opt[BATCH_MAX_PROCS];
+    shrink(pair, w);
+    agree(pair, w, ref, opt);
+
+    printf("\nMismatch in %s, shrunk from %d to %d processes:\n", pair->name, originalCount, w->count);
+    printf("------------------------------------------------------------\n");
+    for (int i = 0; i < w->count; i++) {
+        printf("P%d;%d;%d;%d;%d\n", i, w->jobs[i].arrivalTime, w->jobs[i].burstTime,
+               w->jobs[i].ioInterval, w->jobs[i].ioDuration);
+    }
+    printf("\nPID  Completion   Turnaround   Waiting      Response     (reference/optimised)\n");
+    for (int i = 0; i < w->count; i++) {
+        printf("P%-3d %5d/%-6d %5d/%-6d %5d/%-6d %5d/%-6d\n", i,
+               ref[i].completionTime, opt[i].completionTime,
+               ref[i].turnaroundTime, opt[i].turnaroundTime,
+               ref[i].waitingTime, opt[i].waitingTime,
+               ref[i].responseTime, opt[i].responseTime);
+    }
+    if (compareEvents && !pair->batch) {
+        printf("\n");
+        printTrace("reference", &refTrace);
+        printTrace("optimised", &optTrace);
+    }
+    printf("------------------------------------------------------------\n");
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+typedef struct {
+    const Pair* pair;
+    long numWorkloads;
+    unsigned seed;
+    long nextBlock;
+    long mismatches;
+    pthread_mutex_t lock;
+    long firstIndex;  // lowest failing workload index, -1 if none
+    struct Workload first;
+} Check;
+
+// Checks blocks of workloads until none are left
+void* checkWorker(void* arg) {
+    Check* c = arg;
+    const Pair* pair = c->pair;
+    struct Workload batch[BATCH_LANES];
+    struct Result ref[BATCH_MAX_PROCS];
+    struct Result opt[BATCH_LANES][BATCH_MAX_PROCS];
+
+    for (;;) {
+        long block = __atomic_fetch_add(&c->nextBlock, 1, __ATOMIC_RELAXED);
+        long begin = block * BLOCK_SIZE;
+        if (begin >= c->numWorkloads) break;
+        long end = begin + BLOCK_SIZE < c->numWorkloads ? begin + BLOCK_SIZE : c->numWorkloads;
+        unsigned seed = c->seed * 2654435761u + (unsigned)block;
+        long mismatches = 0;
+
+        for (long k = begin; k < end; k += BATCH_LANES) {
+            // A batch shares one size, so lockstep engines can take it whole
+            int count = 1 + rand_r(&seed) % GEN_MAX_PROCS;
+            for (int l = 0; l < BATCH_LANES; l++) {
+                generateWorkload(&batch[l], count, &seed);
+                if (pair->sorted) sortByArrival(&batch[l]);
+            }
+            if (pair->batch) pair->batch(batch, opt);
+
+            for (int l = 0; l < BATCH_LANES; l++) {
+                bool same;
+                if (pair->batch) {
+                    pair->reference(&batch[l], ref, NULL);
+                    same = sameResults(pair, &batch[l], ref, opt[l]);
+                } else {
+                    same = agree(pair, &batch[l], ref, opt[l]);
+                }
+                if (same) continue;
+                if (mismatches++ == 0) {
+                    pthread_mutex_lock(&c->lock);
+                    if (c->firstIndex < 0 || k + l < c->firstIndex) {
+                        c->firstIndex = k + l;
+                        c->first = batch[l];
+                    }
+                    pthread_mutex_unlock(&c->lock);
+                }
+            }
+        }
+        __atomic_fetch_add(&c->mismatches, mismatches, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+// Checks one pair on numWorkloads workloads; returns the number of mismatches
+long checkPair(const Pair* pair, long numWorkloads, unsigned seed, int numThreads) {
+    Check c = { .pair = pair, .numWorkloads = numWorkloads, .seed = seed,
+                .nextBlock = 0, .mismatches = 0, .firstIndex = -1 };
+    pthread_mutex_init(&c.lock, NULL);
+    pthread_t threads[numThreads];
+    double start = now();
+
+    for (int t = 0; t < numThreads; t++) {
+        pthread_create(&threads[t], NULL, checkWorker, &c);
+    }
+    for (int t = 0; t < numThreads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_mutex_destroy(&c.lock);
+
+    double elapsed = now() - start;
+    printf("%-18s %10ld workloads %8.2fs %12.0f/s   %s%s\n", pair->name, numWorkloads, elapsed,
+           numWorkloads / elapsed, c.mismatches ? "FAIL" : "ok",
+           compareEvents && pair->batch ? "   (results only, no event sequence)" : "");
+    // Only the first counterexample is shrunk and reported
+    if (c.mismatches) reportMismatch(pair, &c.first, c.first.count);
+    return c.mismatches;
+}
+
+int main(int argc, char* argv[]) {
+    long numWorkloads = 1000000;
+    unsigned seed = 1;
+    const char* only = NULL;
+    int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:p:exj:")) != -1) {
+        switch (opt) {
+        case 'n':
+            numWorkloads = atol(optarg);
+            break;
+        case 's':
+            seed = (unsigned)atoi(optarg);
+            break;
+        case 'p':
+            only = optarg;
+            break;
+        case 'e':
+            compareEvents = true;
+            break;
+        case 'x':
+            pairs[NUM_PAIRS - 1].enabled = true;
+            break;
+        case 'j':
+            numThreads = atoi(optarg);
+            break;
+        default:
+            printf("Usage: %s [-n workloads] [-s seed] [-p pair] [-e] [-x] [-j threads]\n", argv[0]);
+            return 2;
+        }
+    }
+    numWorkloads = (numWorkloads + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES;
+    if (numThreads < 1) numThreads = 1;
+
+    printf("Checking the references against the programs' results on data.txt\n");
+    long failed = checkKnown();
+
+    printf("Checking %ld workloads per pair on %d thread(s)%s\n", numWorkloads, numThreads,
+           compareEvents ? ", with event sequences" : "");
+    for (int p = 0; p < NUM_PAIRS; p++) {
+        if (!pairs[p].enabled && !(only && strcmp(only, pairs[p].name) == 0)) continue;
+        if (only && strncmp(pairs[p].name, only, strlen(only)) != 0) continue;
+        // Every pair sees the same workload stream
+        failed += checkPair(&pairs[p], numWorkloads, seed, numThreads) != 0;
+    }
+    printf("%ld check(s) failed\n", failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,463 @@
+#ifndef NODE_H
+#define NODE_H
+
+// Single-machine scheduler that can be fed jobs while it runs.
+//
+// A Node advances one tick at a time and accepts new jobs between ticks, so a
+// dispatcher can hand it work as the work arrives. Each policy makes the same
+// decisions as the corresponding stand-alone simulator:
+//
+//   POLICY_RR    round_robin() in rr.c
+//   POLICY_VRR   processor() in vrr.c
+//   POLICY_SJF   sjf() in SJF.c
+//   POLICY_SRTF  srtf() in SRTF.c
+//
+// provided every job is admitted no later than the tick of its arrival. Ties
+// are broken by admission order, which plays the role of the row order in
+// data.txt.
+//
+// A finished job's slot in procs[] is reused by later admissions, so
+// NODE_MAX_PROCS bounds the jobs on a node at once, not over its lifetime.
+// Callers that need per-job results set Node.results and read them by job id.
+//
+// srtf() counts waiting time for processes arriving at the end of the tick it
+// just ran, and round_robin() admits arrivals up to the end of a slice before
+// re-queueing the preempted process. Both need arrivals one tick ahead, so the
+// node finishes that part of a tick at the start of the next one, once the
+// arrivals for that tick have been admitted.
+//
+// processor() never moves startTime off 0, so its response times are not
+// meaningful; VRR nodes report the tick of the first dispatch instead.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "trace.h"
+
+#define NODE_MAX_PROCS 4096
+#define NODE_QUANTUM 5
+#define NODE_RAN_DONE -2  // prevRan: a process ran and finished, freeing its slot
+
+typedef enum {
+    POLICY_RR,
+    POLICY_VRR,
+    POLICY_SJF,
+    POLICY_SRTF,
+    POLICY_COUNT
+} Policy;
+
+static const char* policyNames[POLICY_COUNT] = { "rr", "vrr", "sjf", "srtf" };
+
+typedef struct {
+    int id;  // caller's job id
+    int arrivalTime, burstTime;
+    int ioInterval, ioDuration;  // columns 4 and 5 of data.txt
+    int remaining;
+    int waitingTime, completionTime, responseTime;
+    int insertedIOtime;  // SJF/SRTF: when the process entered IO
+    int sinceIO;         // SRTF: CPU ticks since the last IO; VRR: lastIOBurst
+    int burstTimeRate;   // RR: rewritten by ino(); VRR: IO after this many ticks
+    int saveContextOfq;  // VRR: quantum position to resume after IO
+    bool inIO, done;
+} NodeProc;
+
+// FIFO of process indices
+typedef struct {
+    int data[NODE_MAX_PROCS];
+    int front;
+    int size;
+} IndexQueue;
+
+typedef struct {
+    Policy policy;
+    int time;  // next tick to simulate
+    NodeProc procs[NODE_MAX_PROCS];
+    int count;      // jobs admitted so far
+    int completed;
+    int slots;      // procs[] entries ever used
+    int freeSlots[NODE_MAX_PROCS];  // entries of finished jobs, ready for reuse
+    int freeCount;
+
+    // Admitted and unfinished processes, in admission order
+    int active[NODE_MAX_PROCS];
+    int activeCount;
+
+    // RR/VRR: admitted processes not yet placed on the ready queue
+    int pending[NODE_MAX_PROCS];
+    int pendingCount;
+
+    IndexQueue readyQ, auxQ, ioQ;
+    int cur;       // process on the CPU, -1 when idle
+    int sliceEnd;  // RR: tick the current slice ends; SJF: ticks left in the chunk
+    int sliceLen;  // RR: length of the current slice
+    int prevRan;   // SRTF: process that ran during the previous tick, or NODE_RAN_DONE
+    int q;         // VRR: position in the time quantum
+    int ioCur;     // VRR: process on the IO device, -1 when idle
+    int ioCount;
+
+    long busyTicks;
+    int lastCompletion;
+    Trace* trace;        // optional, records runs by job id
+    NodeProc* results;   // optional, finished jobs are copied here by job id
+} Node;
+
+static inline void queueInit(IndexQueue* q) {
+    q->front = 0;
+    q->size = 0;
+}
+
+static inline void queuePush(IndexQueue* q, int idx) {
+    if (q->size >= NODE_MAX_PROCS) {
+        printf("Queue overflow\n");
+        exit(1);
+    }
+    q->data[(q->front + q->size++) % NODE_MAX_PROCS] = idx;
+}
+
+static inline int queuePop(IndexQueue* q) {
+    if (q->size == 0) {
+        printf("Queue underflow\n");
+        exit(1);
+    }
+    int idx = q->data[q->front];
+    q->front = (q->front + 1) % NODE_MAX_PROCS;
+    q->size--;
+    return idx;
+}
+
+static inline int parsePolicy(const char* name) {
+    for (int p = 0; p < POLICY_COUNT; p++) {
+        if (strcmp(name, policyNames[p]) == 0) return p;
+    }
+    return -1;
+}
+
+static inline void nodeInit(Node* n, Policy policy) {
+    n->policy = policy;
+    n->time = 0;
+    n->count = 0;
+    n->completed = 0;
+    n->slots = 0;
+    n->freeCount = 0;
+    n->activeCount = 0;
+    n->pendingCount = 0;
+    queueInit(&n->readyQ);
+    queueInit(&n->auxQ);
+    queueInit(&n->ioQ);
+    n->cur = -1;
+    n->sliceEnd = 0;
+    n->sliceLen = 0;
+    n->prevRan = -1;
+    n->q = 0;
+    n->ioCur = -1;
+    n->ioCount = 0;
+    n->busyTicks = 0;
+    n->lastCompletion = 0;
+    n->trace = NULL;
+    n->results = NULL;
+}
+
+// Hands a job to the node. Its arrival must not be before the next tick.
+static inline int nodeAdmit(Node* n, int id, int arrivalTime, int burstTime, int ioInterval, int ioDuration) {
+    int idx;
+    if (n->freeCount > 0) {
+        idx = n->freeSlots[--n->freeCount];
+    } else if (n->slots < NODE_MAX_PROCS) {
+        idx = n->slots++;
+    } else {
+        printf("Node overflow: more than %d unfinished jobs\n", NODE_MAX_PROCS);
+        exit(1);
+    }
+    n->count++;
+    NodeProc* p = &n->procs[idx];
+    p->id = id;
+    p->arrivalTime = arrivalTime;
+    p->burstTime = burstTime;
+    p->ioInterval = ioInterval;
+    p->ioDuration = ioDuration;
+    p->remaining = burstTime;
+    p->waitingTime = 0;
+    p->completionTime = 0;
+    p->responseTime = -1;
+    p->insertedIOtime = -1;
+    p->sinceIO = 0;
+    p->burstTimeRate = ioDuration;
+    p->saveContextOfq = 0;
+    p->inIO = false;
+    p->done = false;
+    n->active[n->activeCount++] = idx;
+    if (n->policy == POLICY_RR || n->policy == POLICY_VRR) {
+        n->pending[n->pendingCount++] = idx;
+    }
+    return idx;
+}
+
+// Jobs on the node that have not finished yet
+static inline int nodeLoad(Node* n) {
+    int load = n->count - n->completed;
+    // A slice that ended on this tick is only settled when the tick runs
+    if (n->policy == POLICY_RR && n->cur >= 0 && n->procs[n->cur].remaining == 0) load--;
+    return load;
+}
+
+// Records a finished job and frees its slot. Set its waitingTime first.
+static inline void nodeComplete(Node* n, int idx, int time) {
+    NodeProc* p = &n->procs[idx];
+    p->done = true;
+    p->completionTime = time;
+    n->completed++;
+    n->lastCompletion = time;
+    if (n->results) n->results[p->id] = *p;
+    n->freeSlots[n->freeCount++] = idx;
+
+    int k = 0;
+    while (n->active[k] != idx) k++;
+    memmove(&n->active[k], &n->active[k + 1], (n->activeCount - k - 1) * sizeof(int));
+    n->activeCount--;
+}
+
+// Moves pending processes that have arrived onto the ready queue, in admission
+// order. VRR only takes exact arrivals, like checkFreshArrivals().
+static inline void nodeAdmitArrivals(Node* n) {
+    int kept = 0;
+    for (int k = 0; k < n->pendingCount; k++) {
+        int idx = n->pending[k];
+        int at = n->procs[idx].arrivalTime;
+        if (n->policy == POLICY_VRR ? at == n->time : at <= n->time) {
+            queuePush(&n->readyQ, idx);
+        } else {
+            n->pending[kept++] = idx;
+        }
+    }
+    n->pendingCount = kept;
+}
+
+static inline void srtfStep(Node* n) {
+    // Waiting time of the previous tick, now that its end-of-tick arrivals are known
+    if (n->prevRan != -1) {
+        for (int k = 0; k < n->activeCount; k++) {
+            NodeProc* p = &n->procs[n->active[k]];
+            if (n->active[k] != n->prevRan && !p->inIO && p->arrivalTime <= n->time) {
+                p->waitingTime++;
+            }
+        }
+    }
+
+    for (int k = 0; k < n->activeCount; k++) {
+        NodeProc* p = &n->procs[n->active[k]];
+        if (p->inIO && (n->time - p->insertedIOtime) >= p->ioDuration) {
+            p->inIO = false;
+            p->insertedIOtime = -1;
+        }
+    }
+
+    int minIdx = -1;
+    for (int k = 0; k < n->activeCount; k++) {
+        int idx = n->active[k];
+        NodeProc* p = &n->procs[idx];
+        if (!p->inIO && p->arrivalTime <= n->time) {
+            if (minIdx == -1 || p->remaining < n->procs[minIdx].remaining) {
+                minIdx = idx;
+            }
+        }
+    }
+
+    n->prevRan = minIdx;
+    if (minIdx == -1) {
+        n->time++;
+        return;
+    }
+
+    NodeProc* p = &n->procs[minIdx];
+    if (p->responseTime == -1) {
+        p->responseTime = n->time - p->arrivalTime;
+    }
+    traceRun(n->trace, p->id, n->time, 1);
+    p->remaining--;
+    n->time++;
+    n->busyTicks++;
+
+    if (p->remaining == 0) {
+        nodeComplete(n, minIdx, n->time);
+        n->prevRan = NODE_RAN_DONE;
+    } else if (++p->sinceIO == p->ioInterval) {
+        p->sinceIO = 0;
+        p->inIO = true;
+        p->insertedIOtime = n->time;
+    }
+}
+
+static inline void sjfStep(Node* n) {
+    if (n->cur == -1) {
+        for (int k = 0; k < n->activeCount; k++) {
+            NodeProc* p = &n->procs[n->active[k]];
+            if (p->inIO && (n->time - p->insertedIOtime) >= p->ioInterval) {
+                p->inIO = false;
+                p->insertedIOtime = -1;
+            }
+        }
+
+        for (int k = 0; k < n->activeCount; k++) {
+            int idx = n->active[k];
+            NodeProc* p = &n->procs[idx];
+            if (!p->inIO && p->arrivalTime <= n->time) {
+                if (n->cur == -1 || p->remaining < n->procs[n->cur].remaining) {
+                    n->cur = idx;
+                }
+            }
+        }
+
+        if (n->cur == -1) {
+            n->time++;
+            return;
+        }
+
+        NodeProc* p = &n->procs[n->cur];
+        if (p->responseTime == -1) {
+            p->responseTime = n->time - p->arrivalTime;
+        }
+        // Run until the process finishes or needs IO
+        n->sliceEnd = (p->remaining < p->ioDuration) ? p->remaining : p->ioDuration;
+    }
+
+    NodeProc* p = &n->procs[n->cur];
+    traceRun(n->trace, p->id, n->time, 1);
+    p->remaining--;
+    n->time++;
+    n->busyTicks++;
+
+    if (--n->sliceEnd == 0) {
+        if (p->remaining == 0) {
+            p->waitingTime = n->time - p->arrivalTime - p->burstTime;
+            nodeComplete(n, n->cur, n->time);
+        } else {
+            p->inIO = true;
+            p->insertedIOtime = n->time;
+        }
+        n->cur = -1;
+    }
+}
+
+static inline void rrStep(Node* n) {
+    // Settle a slice that ended on this tick
+    if (n->cur >= 0 && n->sliceEnd == n->time) {
+        NodeProc* p = &n->procs[n->cur];
+        nodeAdmitArrivals(n);
+        if (p->remaining == 0) {
+            p->waitingTime = n->time - p->arrivalTime - p->burstTime;
+            nodeComplete(n, n->cur, n->time);
+        } else {
+            // ino() in rr.c
+            if (p->burstTimeRate <= n->sliceLen) {
+                p->burstTimeRate = p->ioInterval;
+            }
+            queuePush(&n->readyQ, n->cur);
+        }
+        n->cur = -1;
+    }
+
+    if (n->cur == -1) {
+        nodeAdmitArrivals(n);
+        if (n->readyQ.size == 0) {
+            n->time++;
+            return;
+        }
+        n->cur = queuePop(&n->readyQ);
+        NodeProc* p = &n->procs[n->cur];
+        n->sliceLen = (NODE_QUANTUM < p->remaining) ? NODE_QUANTUM : p->remaining;
+        n->sliceEnd = n->time + n->sliceLen;
+    }
+
+    traceRun(n->trace, n->procs[n->cur].id, n->time, 1);
+    n->procs[n->cur].remaining--;
+    n->time++;
+    n->busyTicks++;
+}
+
+static inline void vrrStep(Node* n) {
+    nodeAdmitArrivals(n);
+
+    if (n->cur >= 0) {
+        NodeProc* p = &n->procs[n->cur];
+        // processor() runs the unit scheduled on the previous tick
+        traceRun(n->trace, p->id, n->time - 1, 1);
+        n->busyTicks++;
+        if (--p->remaining <= 0) {
+            p->waitingTime = n->time - p->arrivalTime - p->burstTime;
+            nodeComplete(n, n->cur, n->time);
+            n->cur = -1;
+        } else if (++p->sinceIO >= p->burstTimeRate) {
+            p->sinceIO = 0;
+            p->saveContextOfq = (n->q + 1) % NODE_QUANTUM;
+            queuePush(&n->ioQ, n->cur);
+            n->cur = -1;
+        }
+    }
+
+    if ((n->readyQ.size || n->auxQ.size) && (n->cur == -1 || n->q + 1 >= NODE_QUANTUM)) {
+        int idx;
+        if (n->auxQ.size) {
+            idx = queuePop(&n->auxQ);
+            n->q = n->procs[idx].saveContextOfq - 1;
+        } else {
+            idx = queuePop(&n->readyQ);
+            n->q = -1;
+        }
+        if (n->cur >= 0) {
+            queuePush(&n->readyQ, n->cur);
+        }
+        if (n->procs[idx].responseTime == -1) {
+            n->procs[idx].responseTime = n->time - n->procs[idx].arrivalTime;
+        }
+        n->cur = idx;
+    }
+
+    // ioDevice()
+    if (n->ioCur >= 0 && ++n->ioCount >= n->procs[n->ioCur].ioInterval) {
+        queuePush(&n->auxQ, n->ioCur);
+        n->ioCur = -1;
+    }
+    if (n->ioCur == -1 && n->ioQ.size) {
+        n->ioCur = queuePop(&n->ioQ);
+        n->ioCount = 0;
+    }
+
+    n->time++;
+    n->q++;
+}
+
+static inline void nodeStep(Node* n) {
+    switch (n->policy) {
+    case POLICY_RR:
+        rrStep(n);
+        break;
+    case POLICY_VRR:
+        vrrStep(n);
+        break;
+    case POLICY_SJF:
+        sjfStep(n);
+        break;
+    case POLICY_SRTF:
+        srtfStep(n);
+        break;
+    default:
+        break;
+    }
+}
+
+// Simulates every tick before until
+static inline void nodeAdvance(Node* n, int until) {
+    while (n->time < until) {
+        nodeStep(n);
+    }
+}
+
+// Runs until every admitted job has finished
+static inline void nodeDrain(Node* n) {
+    while (n->completed < n->count) {
+        nodeStep(n);
+    }
+}
+
+#endif
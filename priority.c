@@ -0,0 +1,301 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Preemptive priority scheduling with aging, O(1) per pick.
+//
+// Ready processes sit in one FIFO per priority level and a bitmap records
+// which levels are non-empty, as in the Linux O(1) scheduler, so picking the
+// next process is a find-first-set on the bitmap. Lower values are higher
+// priority. Processes of equal priority share the CPU round-robin.
+//
+// Aging: a process that has waited AGING_INTERVAL ticks on its level moves up
+// one level. Each level is ordered by the time its processes entered it, so
+// only the head of each non-empty level has to be checked; nobody is scanned.
+// A picked process keeps its aged priority while it holds the CPU, including
+// when a higher priority preempts it, and drops back to its base priority
+// when its time slice expires or it blocks for I/O.
+//
+// Usage: ./priority [agingInterval] [file]   (agingInterval 0 disables aging)
+
+#define MAX_PROCESSES 100
+#define PRIO_LEVELS 32
+#define QUANTUM 5
+#define AGING_INTERVAL 10
+#define IO_WHEEL 64  // minimum size of the timing wheel for IO completions
+
+struct Process {
+    char name[5];
+    int arrivalTime, burstTime, remainingTime;
+    int ioInterval, ioDuration;
+    int priority, effectivePriority;
+    int waitingTime, turnaroundTime, completionTime, responseTime;
+    int readySince;  // when the process last entered the ready queue
+    int levelSince;  // when it entered its current priority level
+    int maxWait;     // longest single stretch spent ready but not running
+    int sinceIO;     // CPU ticks since the last IO
+    int next;        // next process on the same queue or wheel slot
+    bool executed;
+};
+
+struct Process processes[MAX_PROCESSES];
+int processCount = 0;
+
+// Per-level FIFO queues and the bitmap of non-empty levels
+int head[PRIO_LEVELS], tail[PRIO_LEVELS];
+uint32_t bitmap = 0;
+
+// Processes in IO, by the tick their IO completes. The wheel has more slots
+// than the longest IO duration, so an entry never waits more than one lap.
+int *ioWheel = NULL;
+int ioWheelSize = IO_WHEEL;
+
+int agingInterval = AGING_INTERVAL;
+
+// Read process data from file: name;arrival;burst;ioInterval;ioDuration;priority
+void readData(char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening file");
+        exit(1);
+    }
+
+    char line[100];
+    while (fgets(line, sizeof(line), file) && processCount < MAX_PROCESSES) {
+        struct Process *p = &processes[processCount];
+        p->priority = PRIO_LEVELS - 1;
+        if (sscanf(line, "%4[^;];%d;%d;%d;%d;%d", p->name, &p->arrivalTime, &p->burstTime,
+                   &p->ioInterval, &p->ioDuration, &p->priority) < 5)
+            continue;
+        if (p->burstTime <= 0 || p->ioInterval <= 0 || p->ioDuration < 0) {
+            printf("Invalid process %s\n", p->name);
+            exit(1);
+        }
+        if (p->priority < 0) p->priority = 0;
+        if (p->priority >= PRIO_LEVELS) p->priority = PRIO_LEVELS - 1;
+        p->effectivePriority = p->priority;
+        p->remainingTime = p->burstTime;
+        p->waitingTime = 0;
+        p->turnaroundTime = 0;
+        p->completionTime = 0;
+        p->responseTime = -1;
+        p->readySince = 0;
+        p->levelSince = 0;
+        p->maxWait = 0;
+        p->sinceIO = 0;
+        p->next = -1;
+        p->executed = false;
+        processCount++;
+    }
+
+    fclose(file);
+}
+
+void pushLevel(int level, int idx) {
+    processes[idx].next = -1;
+    if (head[level] == -1) {
+        head[level] = idx;
+        bitmap |= 1u << level;
+    } else {
+        processes[tail[level]].next = idx;
+    }
+    tail[level] = idx;
+}
+
+int popLevel(int level) {
+    int idx = head[level];
+    head[level] = processes[idx].next;
+    if (head[level] == -1) {
+        bitmap &= ~(1u << level);
+    }
+    return idx;
+}
+
+// Make a process ready at its effective priority
+void enqueue(int idx, int time) {
+    struct Process *p = &processes[idx];
+    p->readySince = time;
+    p->levelSince = time;
+    pushLevel(p->effectivePriority, idx);
+}
+
+// Highest-priority ready process, or -1
+int dequeue(int time) {
+    if (!bitmap) return -1;
+    int idx = popLevel(__builtin_ctz(bitmap));
+    struct Process *p = &processes[idx];
+    int waited = time - p->readySince;
+    p->waitingTime += waited;
+    if (waited > p->maxWait) p->maxWait = waited;
+    return idx;
+}
+
+// Promote every process that has waited agingInterval ticks on its level.
+// Heads are the longest waiters of each level, so only they need checking.
+void age(int time) {
+    if (agingInterval <= 0) return;
+    uint32_t levels = bitmap & ~1u;
+    while (levels) {
+        int level = __builtin_ctz(levels);
+        levels &= levels - 1;
+        while (head[level] != -1 && time - processes[head[level]].levelSince >= agingInterval) {
+            int idx = popLevel(level);
+            processes[idx].effectivePriority = level - 1;
+            processes[idx].levelSince = time;
+            pushLevel(level - 1, idx);
+        }
+    }
+}
+
+// Print process results
+void printProcesses() {
+    float AWT = 0, ATAT = 0, ART = 0;
+    int maxWait = 0;
+    printf("\nProcess Execution Results:\n");
+    printf("----------------------------------------------------------------------------\n");
+    printf("PID  Priority Arrival  Burst  Completion  Turnaround  Waiting  Response MaxWait\n");
+    for (int i = 0; i < processCount; i++) {
+        printf("%-4s %-8d %-8d %-6d %-11d %-11d %-8d %-8d %-7d\n",
+               processes[i].name,
+               processes[i].priority,
+               processes[i].arrivalTime,
+               processes[i].burstTime,
+               processes[i].completionTime,
+               processes[i].turnaroundTime,
+               processes[i].waitingTime,
+               processes[i].responseTime,
+               processes[i].maxWait);
+        AWT += processes[i].waitingTime;
+        ATAT += processes[i].turnaroundTime;
+        ART += processes[i].responseTime;
+        if (processes[i].maxWait > maxWait) maxWait = processes[i].maxWait;
+    }
+
+    printf("\nAverage Waiting Time : %f\n", AWT / processCount);
+    printf("Average TurnAround Time : %f\n", ATAT / processCount);
+    printf("Average Response Time : %f\n", ART / processCount);
+    printf("Maximum Wait (starvation) : %d\n", maxWait);
+
+    printf("----------------------------------------------------------------------------\n");
+}
+
+// Preemptive priority scheduling with aging and I/O handling
+void priorityScheduling() {
+    if (agingInterval > 0) {
+        printf("\nExecuting Priority (Preemptive) with aging every %d ticks...\n", agingInterval);
+    } else {
+        printf("\nExecuting Priority (Preemptive) without aging...\n");
+    }
+
+    // Arrival order, so admitting arrivals does not scan every process
+    int order[MAX_PROCESSES];
+    for (int i = 0; i < processCount; i++) {
+        int j = i;
+        while (j > 0 && processes[order[j - 1]].arrivalTime > processes[i].arrivalTime) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for (int l = 0; l < PRIO_LEVELS; l++) head[l] = tail[l] = -1;
+    for (int i = 0; i < processCount; i++) {
+        if (processes[i].ioDuration >= ioWheelSize) ioWheelSize = processes[i].ioDuration + 1;
+    }
+    ioWheel = malloc(ioWheelSize * sizeof(int));
+    if (!ioWheel) {
+        perror("Error allocating IO wheel");
+        exit(1);
+    }
+    for (int s = 0; s < ioWheelSize; s++) ioWheel[s] = -1;
+    bitmap = 0;
+
+    int completed = 0, time = 0, arrived = 0;
+    int current = -1, sliceLeft = 0;
+
+    while (completed < processCount) {
+        while (arrived < processCount && processes[order[arrived]].arrivalTime <= time) {
+            enqueue(order[arrived++], time);
+        }
+
+        // Processes whose I/O completes now
+        int slot = time % ioWheelSize;
+        int idx = ioWheel[slot];
+        ioWheel[slot] = -1;
+        while (idx != -1) {
+            int next = processes[idx].next;
+            enqueue(idx, time);
+            idx = next;
+        }
+
+        age(time);
+
+        // An expired slice gives up any priority gained by aging
+        if (current != -1 && sliceLeft == 0) {
+            processes[current].effectivePriority = processes[current].priority;
+        }
+
+        // Preempt for a higher priority, or for an equal one once the slice is used up
+        if (current != -1 && bitmap) {
+            int top = __builtin_ctz(bitmap);
+            int running = processes[current].effectivePriority;
+            if (top < running || (sliceLeft == 0 && top == running)) {
+                enqueue(current, time);
+                current = -1;
+            }
+        }
+
+        if (current == -1) {
+            current = dequeue(time);
+            if (current == -1) {
+                time++;
+                continue;
+            }
+            if (processes[current].responseTime == -1) {
+                processes[current].responseTime = time - processes[current].arrivalTime;
+            }
+            sliceLeft = QUANTUM;
+        } else if (sliceLeft == 0) {
+            sliceLeft = QUANTUM;
+        }
+
+        // Execute process for one time unit
+        struct Process *p = &processes[current];
+        p->remainingTime--;
+        p->sinceIO++;
+        sliceLeft--;
+        time++;
+
+        if (p->remainingTime == 0) {
+            p->executed = true;
+            p->completionTime = time;
+            p->turnaroundTime = p->completionTime - p->arrivalTime;
+            completed++;
+            current = -1;
+        } else if (p->sinceIO == p->ioInterval) {
+            p->sinceIO = 0;
+            p->effectivePriority = p->priority;
+            if (p->ioDuration == 0) {
+                enqueue(current, time);
+            } else {
+                int done = (time + p->ioDuration) % ioWheelSize;
+                p->next = ioWheel[done];
+                ioWheel[done] = current;
+            }
+            current = -1;
+        }
+    }
+
+    free(ioWheel);
+    ioWheel = NULL;
+    printProcesses();
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1) agingInterval = atoi(argv[1]);
+    readData(argc > 2 ? argv[2] : "data.txt");
+    priorityScheduling();
+    return 0;
+}
@@ -0,0 +1,253 @@
+#ifndef PROF_H
+#define PROF_H
+
+// Scheduler-overhead instrumentation.
+//
+// Off by default: unless the program is built with -DSCHED_PROF every PROF_*
+// macro expands to nothing. When enabled, each PROF_BEGIN/PROF_END pair times
+// one phase of a scheduling step, keeps a log2 histogram of the durations and
+// prints a per-phase breakdown at exit.
+//
+// Phases may nest: a phase begun while another is open is charged only to
+// itself, and its time is left out of the enclosing phase. This keeps the
+// simulators' own output (PHASE_LOG) out of the scheduling phases.
+//
+//   -DSCHED_PROF         time phases with clock_gettime(CLOCK_MONOTONIC), in ns
+//   -DSCHED_PROF_RDTSC   use the x86 time-stamp counter instead, in cycles
+//   -DSCHED_PROF_PERF    also count CPU cycles and instructions per phase with
+//                        perf_event_open (Linux, needs perf_event_paranoid <= 2)
+
+enum Phase {
+    PHASE_ARRIVAL,  // admitting newly arrived processes
+    PHASE_IO,       // progressing and completing IO
+    PHASE_PICK,     // choosing the next process to run
+    PHASE_UPDATE,   // running it and updating metrics
+    PHASE_LOG,      // writing the simulator's trace output
+    PHASE_COUNT
+};
+
+#ifdef SCHED_PROF
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef SCHED_PROF_RDTSC
+#include <x86intrin.h>
+#define PROF_UNIT "cycles"
+#else
+#define PROF_UNIT "ns"
+#endif
+
+#ifdef SCHED_PROF_PERF
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#define PROF_BUCKETS 40
+
+typedef struct {
+    uint64_t count;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    uint64_t buckets[PROF_BUCKETS];  // bucket k holds durations in [2^(k-1), 2^k)
+    uint64_t started;
+    uint64_t nested;  // time spent in phases nested inside the open one
+    int parent;       // phase that was open when this one began, or -1
+#ifdef SCHED_PROF_PERF
+    uint64_t cycles, instructions;
+    uint64_t startCycles, startInstructions;
+    uint64_t nestedCycles, nestedInstructions;
+#endif
+} PhaseStats;
+
+static const char* phaseNames[PHASE_COUNT] = { "arrival", "io", "pick", "update", "log" };
+static PhaseStats phaseStats[PHASE_COUNT];
+static uint64_t profStart;
+static int profOpen = -1;
+#ifdef SCHED_PROF_PERF
+static int perfFd = -1;
+#endif
+
+static inline uint64_t profNow(void) {
+#ifdef SCHED_PROF_RDTSC
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+#ifdef SCHED_PROF_PERF
+static int perfOpen(uint64_t config, int groupFd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = groupFd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+// Reads cycles and instructions of the counter group in one syscall
+static void perfRead(uint64_t* cycles, uint64_t* instructions) {
+    uint64_t values[3] = { 0, 0, 0 };
+    if (perfFd >= 0 && read(perfFd, values, sizeof(values)) != (ssize_t)sizeof(values)) {
+        values[1] = values[2] = 0;
+    }
+    *cycles = values[1];
+    *instructions = values[2];
+}
+#endif
+
+static inline void profBegin(enum Phase phase) {
+    PhaseStats* s = &phaseStats[phase];
+    s->parent = profOpen;
+    s->nested = 0;
+    profOpen = phase;
+#ifdef SCHED_PROF_PERF
+    s->nestedCycles = s->nestedInstructions = 0;
+    perfRead(&s->startCycles, &s->startInstructions);
+#endif
+    s->started = profNow();
+}
+
+static inline void profEnd(enum Phase phase) {
+    PhaseStats* s = &phaseStats[phase];
+    uint64_t total = profNow() - s->started;
+    uint64_t elapsed = total - s->nested;
+    profOpen = s->parent;
+    if (s->parent >= 0) phaseStats[s->parent].nested += total;
+#ifdef SCHED_PROF_PERF
+    uint64_t cycles, instructions;
+    perfRead(&cycles, &instructions);
+    cycles -= s->startCycles;
+    instructions -= s->startInstructions;
+    s->cycles += cycles - s->nestedCycles;
+    s->instructions += instructions - s->nestedInstructions;
+    if (s->parent >= 0) {
+        phaseStats[s->parent].nestedCycles += cycles;
+        phaseStats[s->parent].nestedInstructions += instructions;
+    }
+#endif
+    int bucket = elapsed ? 64 - __builtin_clzll(elapsed) : 0;
+    if (bucket >= PROF_BUCKETS) bucket = PROF_BUCKETS - 1;
+    s->buckets[bucket]++;
+    if (s->count == 0 || elapsed < s->min) s->min = elapsed;
+    if (elapsed > s->max) s->max = elapsed;
+    s->total += elapsed;
+    s->count++;
+}
+
+// Upper bound of the bucket holding the given percentile
+static uint64_t profPercentile(PhaseStats* s, double pct) {
+    uint64_t target = (uint64_t)(s->count * pct / 100.0);
+    uint64_t seen = 0;
+    for (int k = 0; k < PROF_BUCKETS; k++) {
+        seen += s->buckets[k];
+        if (seen > target) {
+            uint64_t bound = k ? (1ull << k) - 1 : 0;
+            return bound < s->max ? bound : s->max;
+        }
+    }
+    return s->max;
+}
+
+static void profReport(void) {
+    uint64_t wall = profNow() - profStart;
+    uint64_t measured = 0;
+
+    fprintf(stderr, "\nScheduler overhead (" PROF_UNIT "):\n");
+    fprintf(stderr, "------------------------------------------------------------------------------------------------\n");
+    fprintf(stderr, "Phase     Count       Total         Mean      Min       p50<=     p99<=     Max       Share\n");
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        PhaseStats* s = &phaseStats[p];
+        measured += s->total;
+        if (!s->count) continue;
+        fprintf(stderr, "%-9s %-11llu %-13llu %-9.1f %-9llu %-9llu %-9llu %-9llu %5.1f%%\n",
+                phaseNames[p],
+                (unsigned long long)s->count,
+                (unsigned long long)s->total,
+                (double)s->total / s->count,
+                (unsigned long long)s->min,
+                (unsigned long long)profPercentile(s, 50),
+                (unsigned long long)profPercentile(s, 99),
+                (unsigned long long)s->max,
+                wall ? 100.0 * s->total / wall : 0.0);
+    }
+    fprintf(stderr, "%-9s %-11s %-13llu %49s %5.1f%%\n", "other", "",
+            (unsigned long long)(wall > measured ? wall - measured : 0), "",
+            wall && wall > measured ? 100.0 * (wall - measured) / wall : 0.0);
+
+#ifdef SCHED_PROF_PERF
+    if (perfFd >= 0) {
+        fprintf(stderr, "\nPhase     Cycles        Instructions  IPC\n");
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            PhaseStats* s = &phaseStats[p];
+            if (!s->count) continue;
+            fprintf(stderr, "%-9s %-13llu %-13llu %.2f\n", phaseNames[p],
+                    (unsigned long long)s->cycles, (unsigned long long)s->instructions,
+                    s->cycles ? (double)s->instructions / s->cycles : 0.0);
+        }
+    }
+#endif
+
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        PhaseStats* s = &phaseStats[p];
+        if (!s->count) continue;
+        fprintf(stderr, "\n%s histogram:\n", phaseNames[p]);
+        for (int k = 0; k < PROF_BUCKETS; k++) {
+            if (!s->buckets[k]) continue;
+            int bar = (int)(50 * s->buckets[k] / s->count);
+            fprintf(stderr, "  < %-12llu %-10llu %.*s\n",
+                    k ? 1ull << k : 1ull, (unsigned long long)s->buckets[k],
+                    bar ? bar : 1, "##################################################");
+        }
+    }
+    fprintf(stderr, "------------------------------------------------------------------------------------------------\n");
+
+#ifdef SCHED_PROF_PERF
+    if (perfFd >= 0) close(perfFd);
+#endif
+}
+
+static void profInit(void) {
+#ifdef SCHED_PROF_PERF
+    perfFd = perfOpen(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (perfFd >= 0 && perfOpen(PERF_COUNT_HW_INSTRUCTIONS, perfFd) < 0) {
+        close(perfFd);
+        perfFd = -1;
+    }
+    if (perfFd < 0) {
+        perror("perf_event_open, hardware counters disabled");
+    } else {
+        ioctl(perfFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(perfFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+    profStart = profNow();
+    atexit(profReport);
+}
+
+#define PROF_INIT() profInit()
+#define PROF_BEGIN(phase) profBegin(phase)
+#define PROF_END(phase) profEnd(phase)
+
+#else
+
+#define PROF_INIT() ((void)0)
+#define PROF_BEGIN(phase) ((void)0)
+#define PROF_END(phase) ((void)0)
+
+#endif
+
+#endif
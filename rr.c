@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include "prof.h"
 
 #define Max 4
 
@@ -45,46 +46,58 @@ void round_robin(struct Process * p) {
     int completedProcess = 0;
     
     
+    PROF_BEGIN(PHASE_ARRIVAL);
     for(int i = 0; i < Max; i++) {
         if(p[i].arrivalTime == 0) {
             queue[rear] = i;
             rear++;
         }
     }
+    PROF_END(PHASE_ARRIVAL);
     
     while(completedProcess < Max) {
         if(front == rear) {
             
             time++;
+            PROF_BEGIN(PHASE_ARRIVAL);
             for(int i = 0; i < Max; i++) {
                 if(p[i].arrivalTime == time && !p[i].completed) {
                     queue[rear] = i;
                     rear++;
                 }
             }
+            PROF_END(PHASE_ARRIVAL);
             continue;
         }
         
+        PROF_BEGIN(PHASE_PICK);
         int i = queue[front];
         front = (front + 1) % 100;  
+        PROF_END(PHASE_PICK);
         
     
+        PROF_BEGIN(PHASE_UPDATE);
         int timeSlice = (quantum < p[i].remainingBurst) ? quantum : p[i].remainingBurst;
         
         
         time += timeSlice;
         p[i].remainingBurst -= timeSlice;
         p[i].quantumtime += timeSlice;  
+        PROF_END(PHASE_UPDATE);
         
         
+        PROF_BEGIN(PHASE_ARRIVAL);
         for(int j = 0; j < Max; j++) {
             if(!p[j].completed && p[j].arrivalTime > time - timeSlice && p[j].arrivalTime <= time) {
                 queue[rear] = j;
                 rear = (rear + 1) % 100;  
             }
         }
+        PROF_END(PHASE_ARRIVAL);
         
         
+        // ino() only changes bookkeeping here, so it is counted as update
+        PROF_BEGIN(PHASE_UPDATE);
         if(p[i].remainingBurst == 0) {
             p[i].completionTime = time;
             p[i].completed = true;
@@ -101,6 +114,7 @@ void round_robin(struct Process * p) {
             queue[rear] = i;
             rear = (rear + 1) % 100;  
         }
+        PROF_END(PHASE_UPDATE);
     }
 }
 
@@ -126,6 +140,7 @@ void print(struct Process * p) {
 }
 
 int main() {
+    PROF_INIT();
     struct Process p[Max];
     initProcess(&p[0],0, 24, 2, 5);
     initProcess(&p[1],3, 17, 3, 6);
@@ -0,0 +1,45 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Optional record of what ran on the CPU, for comparing two engines event by
+// event. Consecutive ticks of the same process are merged into one run, so an
+// engine that steps tick by tick and one that runs whole slices produce the
+// same trace. Engines take a Trace* and skip recording when it is NULL.
+
+#include <stdbool.h>
+
+#define TRACE_MAX 4096
+
+typedef struct {
+    int pid;
+    int start, end;  // the process ran during [start, end)
+} TraceRun;
+
+typedef struct {
+    int count;
+    bool overflow;
+    TraceRun runs[TRACE_MAX];
+} Trace;
+
+static inline void traceInit(Trace* t) {
+    t->count = 0;
+    t->overflow = false;
+}
+
+static inline void traceRun(Trace* t, int pid, int start, int len) {
+    if (!t) return;
+    if (t->count && t->runs[t->count - 1].pid == pid && t->runs[t->count - 1].end == start) {
+        t->runs[t->count - 1].end += len;
+        return;
+    }
+    if (t->count == TRACE_MAX) {
+        t->overflow = true;
+        return;
+    }
+    t->runs[t->count].pid = pid;
+    t->runs[t->count].start = start;
+    t->runs[t->count].end = start + len;
+    t->count++;
+}
+
+#endif
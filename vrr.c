@@ -4,9 +4,16 @@
 #include <stddef.h>
 #include <limits.h>
 #include <math.h>
+#include "prof.h"
 
-#define LOG_TICK(ticks) printf("%zu", ticks)
-#define LOG(tick, device, procData) printf("%zu\t%s\t\t%s\n", tick, device, procData)
+// Output is timed as its own profiling phase, outside the scheduling phases
+#define LOG_TICK(ticks) do { PROF_BEGIN(PHASE_LOG); printf("%zu", ticks); PROF_END(PHASE_LOG); } while (0)
+#define LOG(tick, device, procData) LOGF(tick, device, "%s", procData)
+#define LOGF(tick, device, fmt, ...) do { \
+        PROF_BEGIN(PHASE_LOG); \
+        printf("%zu\t%s\t\t" fmt "\n", tick, device, __VA_ARGS__); \
+        PROF_END(PHASE_LOG); \
+    } while (0)
 #define LOG_DEBUG(name, label, info) printf("%s\n\t\t%s\t%zu\n", name, label, info)
 #define MAX_PROCS 100
 #define MAX_NAME_LEN 20
@@ -161,11 +168,9 @@ void initDevice(Device* d, Process procs[], size_t numProcs) {
 
 void checkFreshArrivals(Device* d) {
     int i = 0;
-    char buffer[100];
     while (i < d->numProcs) {
         if (d->procs[i].arrivalTime == d->ticksCPU) {
-            snprintf(buffer, sizeof(buffer), "%s[Arrive]", d->procs[i].procName);
-            LOG(d->ticksCPU, "CPU", buffer);
+            LOGF(d->ticksCPU, "CPU", "%s[Arrive]", d->procs[i].procName);
             d->procs[i].state = READY;
             enqueue(&d->readyQ, d->procs[i]);
             
@@ -181,17 +186,14 @@ void checkFreshArrivals(Device* d) {
 }
 
 void ioDevice(Device* d) {
-    char buffer[100];
     if (!d->isIOIdle) {
         if (++d->countIOBurst >= d->execProcIO.burstTimeIO) {
-            snprintf(buffer, sizeof(buffer), "%s[Comp]:%zu", d->execProcIO.procName, d->countIOBurst);
-            LOG(d->ticksCPU, "IO", buffer);
+            LOGF(d->ticksCPU, "IO", "%s[Comp]:%zu", d->execProcIO.procName, d->countIOBurst);
             enqueue(&d->auxQ, d->execProcIO);
             memset(&d->execProcIO, 0, sizeof(Process));
             d->isIOIdle = 1;
         } else {
-            snprintf(buffer, sizeof(buffer), "%s:%zu", d->execProcIO.procName, d->countIOBurst);
-            LOG(d->ticksCPU, "IO", buffer);
+            LOGF(d->ticksCPU, "IO", "%s:%zu", d->execProcIO.procName, d->countIOBurst);
         }
     }
 
@@ -199,8 +201,7 @@ void ioDevice(Device* d) {
         d->execProcIO = dequeue(&d->ioQ);
         d->countIOBurst = 0;
         d->isIOIdle = 0;
-        snprintf(buffer, sizeof(buffer), "%s[Sched]:%zu", d->execProcIO.procName, d->countIOBurst);
-        LOG(d->ticksCPU, "IO", buffer);
+        LOGF(d->ticksCPU, "IO", "%s[Sched]:%zu", d->execProcIO.procName, d->countIOBurst);
     }
 }
 
@@ -208,7 +209,6 @@ void processor(Device* d) {
     Process execProc;
     memset(&execProc, 0, sizeof(Process));
     int q = 0;
-    char buffer[100];
     
     printf("Time (tick)\tDevice\t\tProcess Served\n");
     
@@ -218,31 +218,33 @@ void processor(Device* d) {
             LOG(d->ticksCPU, "CPU", "-");
         }
         
+        PROF_BEGIN(PHASE_ARRIVAL);
         checkFreshArrivals(d);
+        PROF_END(PHASE_ARRIVAL);
 
+        PROF_BEGIN(PHASE_UPDATE);
         if (!d->isCPUIdle) {
             execProcess(&execProc);
             if (execProc.state == TERMINATED) {
-                snprintf(buffer, sizeof(buffer), "%s[Comp]", execProc.procName);
-                LOG(d->ticksCPU, "CPU", buffer);
+                LOGF(d->ticksCPU, "CPU", "%s[Comp]", execProc.procName);
                 d->isCPUIdle = 1;
                 d->totalProc--;
                 execProc.completionTime = d->ticksCPU;
                 d->completedProcs[d->numCompletedProcs++] = execProc;
                 memset(&execProc, 0, sizeof(Process));
             } else if (execProc.state == BLOCKED) {
-                snprintf(buffer, sizeof(buffer), "%s[Q IO]:%zu", execProc.procName, execProc.burstRemainCPU);
-                LOG(d->ticksCPU, "CPU", buffer);
+                LOGF(d->ticksCPU, "CPU", "%s[Q IO]:%zu", execProc.procName, execProc.burstRemainCPU);
                 execProc.saveContextOfq = (q + 1) % d->timeQuantum;
                 enqueue(&d->ioQ, execProc);
                 d->isCPUIdle = 1;
                 memset(&execProc, 0, sizeof(Process));
             } else {
-                snprintf(buffer, sizeof(buffer), "%s:%zu", execProc.procName, execProc.burstRemainCPU);
-                LOG(d->ticksCPU, "CPU", buffer);
+                LOGF(d->ticksCPU, "CPU", "%s:%zu", execProc.procName, execProc.burstRemainCPU);
             }
         }
+        PROF_END(PHASE_UPDATE);
 
+        PROF_BEGIN(PHASE_PICK);
         int toSchedule = (!isEmpty(&d->readyQ) || !isEmpty(&d->auxQ)) && 
                          (d->isCPUIdle || q + 1 >= d->timeQuantum);
         
@@ -258,17 +260,21 @@ void processor(Device* d) {
             if (!d->isCPUIdle) {
                 enqueue(&d->readyQ, execProc);
             }
-            snprintf(buffer, sizeof(buffer), "%s[Sched]#q=%d", proc.procName, q + 1);
-            LOG(d->ticksCPU, "CPU", buffer);
+            LOGF(d->ticksCPU, "CPU", "%s[Sched]#q=%d", proc.procName, q + 1);
             execProc = proc;
             execProc.startTime = MIN(execProc.startTime, d->ticksCPU);
             d->isCPUIdle = 0;
         }
+        PROF_END(PHASE_PICK);
 
+        PROF_BEGIN(PHASE_IO);
         ioDevice(d);
+        PROF_END(PHASE_IO);
         d->ticksCPU++;
         q++;
+        PROF_BEGIN(PHASE_LOG);
         printf("\n");
+        PROF_END(PHASE_LOG);
     }
 }
 
@@ -295,6 +301,7 @@ void debugDevice(Device* d) {
 }
 
 int main() {
+    PROF_INIT();
     Process procs[4];
     initProcess(&procs[0], "P0", 0, 24, 2, 5);
     initProcess(&procs[1], "P1", 3, 17, 3, 6);